@@ -4,7 +4,7 @@
 #include <stdlib.h>
 
 int buscaBinaria (int arr[], int esq, int dir, int alvo) {
-    int meio = (esq + dir) / 2;
+    int meio = esq + (dir - esq) / 2; // Evita o estouro de esq + dir
 
     // Caso base: alvo não encontrado
     if (esq > dir) {
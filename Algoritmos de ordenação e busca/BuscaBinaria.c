@@ -11,7 +11,7 @@ int buscaBinaria (int A[], int k){
     int meio;
 
     while (ini <= fim) {
-        meio = (ini + fim) / 2;
+        meio = ini + (fim - ini) / 2; // Evita o estouro de ini + fim
         if (k < A[meio]) {
             fim = meio - 1;
         } 
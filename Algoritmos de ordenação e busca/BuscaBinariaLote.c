@@ -0,0 +1,154 @@
+// ## Busca Binária em Lote com Prefetch Intercalado ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define tamGrupo 32 // Consultas avançadas juntas, um nível por vez
+#define tamPadrao (1 << 24) // 16M inteiros (64 MB)
+#define qtdConsultas 4000000
+
+/*
+Obs.: cada chamada de buscaBinaria fica parada esperando a memória em quase todos os passos, porque o próximo acesso depende do resultado do anterior. Uma consulta isolada não tem o que fazer durante a espera, mas várias consultas independentes têm.
+
+A busca em lote (group prefetching) avança um grupo de consultas um nível por vez: para cada consulta do grupo, faz a comparação do nível atual e já emite o prefetch do pivô do próximo nível. Quando o laço volta à primeira consulta do grupo, a linha de cache dela já chegou, e as tamGrupo falhas de cache ficam sobrepostas em vez de enfileiradas.
+
+Como a busca é sem desvio (ver BuscaBinariaSemDesvio.c), o número de níveis depende apenas de n, e todas as consultas do grupo terminam juntas. Por isso não é necessária uma máquina de estados por consulta (AMAC): o agendamento estático em grupo é suficiente.
+*/
+
+// Busca binária tradicional (BuscaBinaria.c), com o tamanho como parâmetro
+int buscaBinaria (int A[], int n, int k) {
+    int ini = 0;
+    int fim = n - 1;
+    int meio;
+
+    while (ini <= fim) {
+        meio = ini + (fim - ini) / 2;
+        if (k < A[meio]) {
+            fim = meio - 1;
+        }
+        else if (k > A[meio]) {
+            ini = meio + 1;
+        }
+        else {
+            return meio;
+        }
+    }
+
+    return -1;
+}
+
+// Resolve um grupo de até tamGrupo consultas. R[j] recebe o índice de Q[j] em A ou -1
+void buscaGrupo (const int A[], int n, const int Q[], int qtd, int R[]) {
+    const int *base[tamGrupo];
+    int tam = n;
+
+    for (int j = 0; j < qtd; j++) {
+        base[j] = A;
+    }
+
+    while (tam > 1) {
+        int metade = tam / 2;
+        int proxima = (tam - metade) / 2; // Metade do próximo nível (0 no último)
+        int deslocamento = (proxima > 0) ? proxima - 1 : 0;
+
+        for (int j = 0; j < qtd; j++) {
+            base[j] += (base[j][metade - 1] < Q[j]) * metade;
+            __builtin_prefetch(base[j] + deslocamento); // Pivô do próximo nível desta consulta
+        }
+
+        tam -= metade;
+    }
+
+    for (int j = 0; j < qtd; j++) {
+        int i = (int)(base[j] - A) + (*base[j] < Q[j]);
+        R[j] = (i < n && A[i] == Q[j]) ? i : -1;
+    }
+}
+
+// Busca qtd chaves de Q no vetor ordenado A. R[i] recebe o índice de Q[i] ou -1
+void buscaBinariaLote (const int A[], int n, const int Q[], int qtd, int R[]) {
+    if (n == 0) {
+        for (int i = 0; i < qtd; i++) {
+            R[i] = -1;
+        }
+        return;
+    }
+
+    for (int i = 0; i < qtd; i += tamGrupo) {
+        int resto = qtd - i;
+        buscaGrupo(A, n, Q + i, resto < tamGrupo ? resto : tamGrupo, R + i);
+    }
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main (int argc, char *argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : tamPadrao;
+
+    if (n <= 0) {
+        printf("Tamanho inválido.\n");
+        return 1;
+    }
+
+    printf("## Busca Binária em Lote ##\n");
+    printf("Vetor com %d inteiros (%.1f MB), %d consultas, grupos de %d.\n\n", n, n * 4.0 / (1 << 20), qtdConsultas, tamGrupo);
+
+    int *A = (int *)malloc(sizeof(int) * n);
+    int *Q = (int *)malloc(sizeof(int) * qtdConsultas);
+    int *R = (int *)malloc(sizeof(int) * qtdConsultas);
+
+    // Verifica a alocação de memória
+    if (A == NULL || Q == NULL || R == NULL) {
+        printf("Não foi possível alocar memória para os vetores.\n");
+        return 1;
+    }
+
+    // Vetor ordenado com as chaves pares
+    for (int i = 0; i < n; i++) {
+        A[i] = 2 * i;
+    }
+
+    srand(5);
+    for (int i = 0; i < qtdConsultas; i++) {
+        long int r = ((long int)rand() << 16) ^ rand();
+        Q[i] = (int)(r % (2L * n));
+    }
+
+    // Uma consulta por vez
+    long int encontradas = 0;
+    double inicio = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        encontradas += buscaBinaria(A, n, Q[i]) != -1;
+    }
+    double tUnitaria = agora() - inicio;
+    printf("buscaBinaria:      %6.1f ns/consulta (%ld encontradas)\n", tUnitaria * 1e9 / qtdConsultas, encontradas);
+
+    // Em lote
+    inicio = agora();
+    buscaBinariaLote(A, n, Q, qtdConsultas, R);
+    double tLote = agora() - inicio;
+
+    encontradas = 0;
+    int erros = 0;
+    for (int i = 0; i < qtdConsultas; i++) {
+        encontradas += R[i] != -1;
+        if (R[i] != buscaBinaria(A, n, Q[i])) {
+            erros++;
+        }
+    }
+    printf("buscaBinariaLote:  %6.1f ns/consulta (%ld encontradas, %.2fx)\n", tLote * 1e9 / qtdConsultas, encontradas, tUnitaria / tLote);
+    printf("Conferência: %d divergências.\n", erros);
+
+    // Libera a memória
+    free(A);
+    free(Q);
+    free(R);
+
+    return 0;
+}
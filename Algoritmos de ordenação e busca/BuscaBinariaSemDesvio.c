@@ -0,0 +1,216 @@
+// ## Busca Binária sem Desvio e Layout de Eytzinger ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define tamPadrao (1 << 22) // 4M inteiros (16 MB); passe outro tamanho pela linha de comando
+#define qtdConsultas 2000000
+#define niveisPrefetch 4 // 2^4 = 16 inteiros = 1 linha de cache de 64 bytes
+
+/*
+Obs.: a busca binária tradicional toma, a cada passo, um desvio que depende do dado (k < A[meio]?). O processador não consegue prever esse desvio e descarta o trabalho especulativo em metade das vezes. Além disso, os acessos saltam pelo vetor inteiro, e cada passo é uma falha de cache quando o vetor não cabe no L3.
+
+1) Busca sem desvio: o laço sempre executa ceil(log2(n)) iterações e a comparação vira aritmética (o compilador gera um cmov), então não há desvio a prever. Como o processador deixa de especular o próximo acesso, os dois pivôs possíveis do passo seguinte são buscados com prefetch.
+
+2) Layout de Eytzinger: o vetor é reescrito na ordem de uma busca em largura da árvore binária implícita (raiz em E[1], filhos de k em E[2k] e E[2k+1]). Os primeiros níveis ficam juntos no cache, e os 16 descendentes de k quatro níveis abaixo (E[16k..16k+15]) ocupam uma única linha de cache, que pode ser buscada antecipadamente com prefetch.
+*/
+
+// Busca binária tradicional (BuscaBinaria.c), com o tamanho como parâmetro
+int buscaBinaria (int A[], int n, int k) {
+    int ini = 0;
+    int fim = n - 1;
+    int meio;
+
+    while (ini <= fim) {
+        meio = ini + (fim - ini) / 2;
+        if (k < A[meio]) {
+            fim = meio - 1;
+        }
+        else if (k > A[meio]) {
+            ini = meio + 1;
+        }
+        else {
+            return meio;
+        }
+    }
+
+    return -1;
+}
+
+// Retorna o índice do primeiro elemento >= k (n se não houver), sem desvios dependentes do dado
+int lowerBoundSemDesvio (const int A[], int n, int k) {
+    const int *base = A;
+    int tam = n;
+
+    if (n == 0) {
+        return 0;
+    }
+
+    while (tam > 1) {
+        int metade = tam / 2;
+
+        // Sem desvio não há especulação: busca antecipadamente os dois próximos pivôs possíveis
+        __builtin_prefetch(base + metade / 2 - 1);
+        __builtin_prefetch(base + metade + metade / 2 - 1);
+
+        base += (base[metade - 1] < k) * metade; // cmov em vez de desvio
+        tam -= metade;
+    }
+
+    return (int)(base - A) + (*base < k);
+}
+
+// Busca sem desvio com a mesma interface da buscaBinaria
+int buscaSemDesvio (const int A[], int n, int k) {
+    int i = lowerBoundSemDesvio(A, n, k);
+    return (i < n && A[i] == k) ? i : -1;
+}
+
+// Preenche E na ordem de Eytzinger a partir do vetor ordenado A (percurso em ordem da árvore implícita)
+int preencheEytzinger (const int A[], int n, int E[], int i, int k) {
+    if (k <= n) {
+        i = preencheEytzinger(A, n, E, i, 2 * k); // Subárvore esquerda
+        E[k] = A[i++]; // Nó
+        i = preencheEytzinger(A, n, E, i, 2 * k + 1); // Subárvore direita
+    }
+    return i;
+}
+
+// Constrói o layout de Eytzinger de A. O índice 0 é desprezado, como no Heap.c
+int *constroiEytzinger (const int A[], int n) {
+    // Alinhado a 64 bytes para que E[16k..16k+15] caiba em uma única linha de cache
+    size_t bytes = sizeof(int) * (size_t)(n + 1);
+    bytes = (bytes + 63) / 64 * 64;
+    int *E = (int *)aligned_alloc(64, bytes);
+
+    // Verifica a alocação de memória
+    if (E == NULL) {
+        printf("Não foi possível alocar memória para o layout de Eytzinger.\n");
+        return NULL;
+    }
+
+    E[0] = -1; // Desprezado
+    preencheEytzinger(A, n, E, 0, 1);
+
+    return E;
+}
+
+// Retorna a posição em E do primeiro elemento >= k (0 se não houver)
+int lowerBoundEytzinger (const int E[], int n, int k) {
+    int i = 1;
+
+    while (i <= n) {
+        // Busca os descendentes de i que estão niveisPrefetch níveis abaixo
+        __builtin_prefetch(E + ((long int)i << niveisPrefetch));
+        i = 2 * i + (E[i] < k); // Desce para a esquerda (k <= E[i]) ou para a direita
+    }
+
+    // Desfaz as descidas à direita feitas depois da última descida à esquerda
+    i >>= __builtin_ffs(~i);
+
+    return i;
+}
+
+// Busca no layout de Eytzinger. Retorna a posição em E ou -1
+int buscaEytzinger (const int E[], int n, int k) {
+    int i = lowerBoundEytzinger(E, n, k);
+    return (i != 0 && E[i] == k) ? i : -1;
+}
+
+// Gera consultas aleatórias (metade presentes, metade ausentes)
+void geraConsultas (int Q[], int qtd, int n) {
+    for (int i = 0; i < qtd; i++) {
+        long int r = ((long int)rand() << 16) ^ rand();
+        Q[i] = (int)(r % (2L * n)); // Chaves pares estão no vetor; ímpares, não
+    }
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main (int argc, char *argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : tamPadrao;
+
+    if (n <= 0) {
+        printf("Tamanho inválido.\n");
+        return 1;
+    }
+
+    printf("## Busca Binária sem Desvio e Eytzinger ##\n");
+    printf("Vetor com %d inteiros (%.1f MB), %d consultas.\n\n", n, n * 4.0 / (1 << 20), qtdConsultas);
+
+    int *A = (int *)malloc(sizeof(int) * n);
+    int *Q = (int *)malloc(sizeof(int) * qtdConsultas);
+
+    // Verifica a alocação de memória
+    if (A == NULL || Q == NULL) {
+        printf("Não foi possível alocar memória para o vetor.\n");
+        return 1;
+    }
+
+    // Vetor ordenado com as chaves pares
+    for (int i = 0; i < n; i++) {
+        A[i] = 2 * i;
+    }
+
+    int *E = constroiEytzinger(A, n);
+    if (E == NULL) {
+        return 1;
+    }
+
+    srand(1);
+    geraConsultas(Q, qtdConsultas, n);
+
+    // Confere as três buscas entre si
+    int erros = 0;
+    for (int i = 0; i < qtdConsultas; i++) {
+        int b = buscaBinaria(A, n, Q[i]);
+        int s = buscaSemDesvio(A, n, Q[i]);
+        int e = buscaEytzinger(E, n, Q[i]);
+
+        if (b != s || (b == -1) != (e == -1) || (e != -1 && E[e] != Q[i])) {
+            erros++;
+        }
+    }
+    printf("Conferência: %d divergências.\n\n", erros);
+
+    // Medição
+    double t;
+    long int soma;
+
+    soma = 0;
+    t = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        soma += buscaBinaria(A, n, Q[i]);
+    }
+    double tBinaria = agora() - t;
+    printf("buscaBinaria:      %6.1f ns/consulta (soma %ld)\n", tBinaria * 1e9 / qtdConsultas, soma);
+
+    soma = 0;
+    t = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        soma += buscaSemDesvio(A, n, Q[i]);
+    }
+    double tSemDesvio = agora() - t;
+    printf("buscaSemDesvio:    %6.1f ns/consulta (soma %ld, %.2fx)\n", tSemDesvio * 1e9 / qtdConsultas, soma, tBinaria / tSemDesvio);
+
+    soma = 0;
+    t = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        soma += buscaEytzinger(E, n, Q[i]);
+    }
+    double tEytzinger = agora() - t;
+    printf("buscaEytzinger:    %6.1f ns/consulta (soma %ld, %.2fx)\n", tEytzinger * 1e9 / qtdConsultas, soma, tBinaria / tEytzinger);
+
+    // Libera a memória
+    free(A);
+    free(Q);
+    free(E);
+
+    return 0;
+}
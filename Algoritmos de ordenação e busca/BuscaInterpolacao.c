@@ -0,0 +1,362 @@
+// ## Busca por Interpolação, Exponencial e Galopante ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+
+#define tamPadrao 10000000
+#define qtdConsultas 2000000
+
+/*
+Obs.: a buscaBinaria sempre divide o intervalo ao meio, sem olhar para os valores. Há dois casos comuns em que dá para fazer melhor:
+
+1) Interpolação: se as chaves são quase uniformes (como as matrículas), a posição de k pode ser estimada por uma regra de três entre A[ini] e A[fim]. Em dados uniformes o intervalo cai para cerca de sqrt(tamanho) a cada passo, e a busca faz O(log log n) acessos. Em dados enviesados a estimativa pode errar muito; por isso, sempre que uma sondagem não reduz o intervalo pela metade, é feito também um passo de busca binária, e o pior caso continua O(log n).
+
+2) Exponencial (galopante): quando a chave está perto de uma posição conhecida (a dica, ex.: o último acerto), testam-se as posições dica + 1, dica + 2, dica + 4, ... até ultrapassar k, e a busca binária é feita só no último salto. O custo é O(log d), em que d é a distância até a dica. Partindo do início, a busca também serve para vetores sem tamanho conhecido (fluxos ordenados).
+*/
+
+// Busca binária tradicional (BuscaBinaria.c) em long int, com os limites como parâmetro
+long int buscaBinaria (const long int A[], long int ini, long int fim, long int k) {
+    while (ini <= fim) {
+        long int meio = ini + (fim - ini) / 2;
+        if (k < A[meio]) {
+            fim = meio - 1;
+        }
+        else if (k > A[meio]) {
+            ini = meio + 1;
+        }
+        else {
+            return meio;
+        }
+    }
+
+    return -1;
+}
+
+// Retorna o índice de k em A[0..n-1] ou -1, por interpolação com recurso à busca binária
+long int buscaInterpolacao (const long int A[], long int n, long int k) {
+    long int ini = 0;
+    long int fim = n - 1;
+
+    while (ini <= fim && k >= A[ini] && k <= A[fim]) {
+        // Todas as chaves do intervalo são iguais
+        if (A[fim] == A[ini]) {
+            return ini;
+        }
+
+        long int tamAnterior = fim - ini;
+
+        // Regra de três em 128 bits: (k - A[ini]) * (fim - ini) pode estourar 64 bits
+        long int pos = ini + (long int)((__int128)(k - A[ini]) * (fim - ini) / (A[fim] - A[ini]));
+
+        if (A[pos] < k) {
+            ini = pos + 1;
+        }
+        else if (A[pos] > k) {
+            fim = pos - 1;
+        }
+        else {
+            return pos;
+        }
+
+        // A sondagem não reduziu o intervalo pela metade: faz um passo de busca binária
+        if (ini <= fim && fim - ini > tamAnterior / 2) {
+            long int meio = ini + (fim - ini) / 2;
+            if (A[meio] < k) {
+                ini = meio + 1;
+            }
+            else if (A[meio] > k) {
+                fim = meio - 1;
+            }
+            else {
+                return meio;
+            }
+        }
+    }
+
+    return -1;
+}
+
+// Retorna o primeiro índice i >= dica com A[i] >= k (n se não houver), galopando a partir da dica
+long int galopa (const long int A[], long int n, long int dica, long int k) {
+    if (dica >= n || A[dica] >= k) {
+        return dica;
+    }
+
+    // A[ini] < k; procura fim com A[fim] >= k dobrando o salto
+    long int ini = dica;
+    long int salto = 1;
+    long int fim = dica + salto;
+
+    while (fim < n && A[fim] < k) {
+        ini = fim;
+        salto *= 2;
+        fim = dica + salto;
+    }
+
+    if (fim > n) {
+        fim = n;
+    }
+
+    // Busca binária (lower bound) em (ini, fim]
+    ini++;
+    while (ini < fim) {
+        long int meio = ini + (fim - ini) / 2;
+        if (A[meio] < k) {
+            ini = meio + 1;
+        }
+        else {
+            fim = meio;
+        }
+    }
+
+    return ini;
+}
+
+// Retorna o índice de k em A ou -1, galopando em qualquer direção a partir da dica
+long int buscaGalopante (const long int A[], long int n, long int dica, long int k) {
+    if (n == 0) {
+        return -1;
+    }
+
+    if (dica < 0) {
+        dica = 0;
+    }
+    if (dica >= n) {
+        dica = n - 1;
+    }
+
+    // Chave à direita (ou na própria dica): galopa para frente
+    if (A[dica] <= k) {
+        long int i = galopa(A, n, dica, k);
+        return (i < n && A[i] == k) ? i : -1;
+    }
+
+    // Chave à esquerda: galopa para trás até A[fim - salto] < k
+    long int fim = dica;
+    long int salto = 1;
+    long int ini = dica - salto;
+
+    while (ini > 0 && A[ini] > k) {
+        fim = ini;
+        salto *= 2;
+        ini = dica - salto;
+    }
+
+    if (ini < 0) {
+        ini = 0;
+    }
+
+    return buscaBinaria(A, ini, fim, k);
+}
+
+// Busca exponencial a partir do início: só lê posições até cerca do dobro do índice de k
+long int buscaExponencial (const long int A[], long int n, long int k) {
+    long int i = galopa(A, n, 0, k);
+    return (i < n && A[i] == k) ? i : -1;
+}
+
+// Busca exponencial em uma sequência ordenada sem tamanho conhecido (fluxo)
+// elemento(i, ctx) deve retornar LONG_MAX para posições além do fim
+long int buscaIlimitada (long int (*elemento)(long int i, void *ctx), void *ctx, long int k) {
+    long int ini = 0;
+    long int fim = 1;
+
+    // Dobra o limite até ultrapassar k (ou o fim da sequência)
+    while (elemento(fim, ctx) < k) {
+        ini = fim;
+        fim *= 2;
+    }
+
+    // Busca binária em [ini, fim]
+    while (ini <= fim) {
+        long int meio = ini + (fim - ini) / 2;
+        long int valor = elemento(meio, ctx);
+        if (k < valor) {
+            fim = meio - 1;
+        }
+        else if (k > valor) {
+            ini = meio + 1;
+        }
+        else {
+            return meio;
+        }
+    }
+
+    return -1;
+}
+
+// ##################################################### //
+// DEMONSTRAÇÃO E MEDIÇÕES
+
+// Fluxo de exemplo: os múltiplos de 3 até um limite não informado à busca
+typedef struct Fluxo {
+    long int limite;
+} Fluxo;
+
+long int elementoFluxo (long int i, void *ctx) {
+    Fluxo *f = (Fluxo *)ctx;
+    return (i < f->limite) ? 3 * i : LONG_MAX;
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Número aleatório de 62 bits
+long int aleatorio () {
+    return ((long int)rand() << 31) ^ rand();
+}
+
+int comparaLong (const void *a, const void *b) {
+    long int x = *(const long int *)a;
+    long int y = *(const long int *)b;
+    return (x > y) - (x < y);
+}
+
+// Mede buscaBinaria contra outra busca (sem dica) sobre as mesmas consultas, conferindo o resultado de cada consulta
+void mede (const char *nome, const long int A[], long int n, const long int Q[], long int (*busca)(const long int *, long int, long int)) {
+    long int *esperado = (long int *)malloc(sizeof(long int) * qtdConsultas);
+    long int *obtido = (long int *)malloc(sizeof(long int) * qtdConsultas);
+
+    // Verifica a alocação de memória
+    if (esperado == NULL || obtido == NULL) {
+        printf("Não foi possível alocar memória para os resultados.\n");
+        free(esperado);
+        free(obtido);
+        return;
+    }
+
+    double inicio = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        esperado[i] = buscaBinaria(A, 0, n - 1, Q[i]);
+    }
+    double tBinaria = agora() - inicio;
+
+    inicio = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        obtido[i] = busca(A, n, Q[i]);
+    }
+    double tOutra = agora() - inicio;
+
+    // Índice (ou -1) de cada consulta igual ao da buscaBinaria (as chaves são distintas)
+    int divergencias = 0;
+    for (int i = 0; i < qtdConsultas; i++) {
+        divergencias += obtido[i] != esperado[i];
+    }
+
+    printf("%-38s buscaBinaria %6.1f ns | nova %6.1f ns | %.2fx | divergências: %d\n", nome, tBinaria * 1e9 / qtdConsultas, tOutra * 1e9 / qtdConsultas, tBinaria / tOutra, divergencias);
+
+    free(esperado);
+    free(obtido);
+}
+
+int main (int argc, char *argv[]) {
+    long int n = (argc > 1) ? atol(argv[1]) : tamPadrao;
+
+    if (n <= 0) {
+        printf("Tamanho inválido.\n");
+        return 1;
+    }
+
+    long int *A = (long int *)malloc(sizeof(long int) * n);
+    long int *Q = (long int *)malloc(sizeof(long int) * qtdConsultas);
+
+    // Verifica a alocação de memória
+    if (A == NULL || Q == NULL) {
+        printf("Não foi possível alocar memória para os vetores.\n");
+        return 1;
+    }
+
+    printf("## Busca por Interpolação, Exponencial e Galopante ##\n");
+    printf("%ld chaves, %d consultas.\n\n", n, qtdConsultas);
+
+    // Matrículas quase uniformes: 11 dígitos, passo médio de 1000
+    srand(11);
+    A[0] = 10000000000L;
+    for (long int i = 1; i < n; i++) {
+        A[i] = A[i - 1] + 1 + rand() % 1999;
+    }
+
+    for (int i = 0; i < qtdConsultas; i++) {
+        Q[i] = (i % 2) ? A[aleatorio() % n] : A[0] + aleatorio() % (A[n - 1] - A[0]); // Metade acertos
+    }
+
+    mede("Interpolação (matrículas uniformes):", A, n, Q, buscaInterpolacao);
+    mede("Exponencial (matrículas uniformes):", A, n, Q, buscaExponencial);
+
+    // Dados enviesados (quadrados): a interpolação erra e recorre à binária
+    for (long int i = 0; i < n; i++) {
+        A[i] = i * i;
+    }
+    for (int i = 0; i < qtdConsultas; i++) {
+        Q[i] = (i % 2) ? A[aleatorio() % n] : aleatorio() % A[n - 1];
+    }
+    mede("Interpolação (quadrados, enviesado):", A, n, Q, buscaInterpolacao);
+
+    // Consultas próximas do último acerto: galopante com dica
+    for (long int i = 0; i < n; i++) {
+        A[i] = 10000000000L + 3 * i;
+    }
+    for (int i = 0; i < qtdConsultas; i++) {
+        Q[i] = A[0] + aleatorio() % (3 * n);
+    }
+    qsort(Q, qtdConsultas, sizeof(long int), comparaLong);
+
+    long int *esperado = (long int *)malloc(sizeof(long int) * qtdConsultas);
+    long int *obtido = (long int *)malloc(sizeof(long int) * qtdConsultas);
+
+    // Verifica a alocação de memória
+    if (esperado == NULL || obtido == NULL) {
+        printf("Não foi possível alocar memória para os resultados.\n");
+        return 1;
+    }
+
+    double inicio = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        esperado[i] = buscaBinaria(A, 0, n - 1, Q[i]);
+    }
+    double tBinaria = agora() - inicio;
+
+    long int dica = 0;
+    inicio = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        dica = galopa(A, n, dica, Q[i]); // Lower bound a partir do último acerto
+        obtido[i] = (dica < n && A[dica] == Q[i]) ? dica : -1;
+    }
+    double tGalope = agora() - inicio;
+
+    int erros = 0;
+    for (int i = 0; i < qtdConsultas; i++) {
+        erros += obtido[i] != esperado[i];
+    }
+
+    printf("%-38s buscaBinaria %6.1f ns | nova %6.1f ns | %.2fx | divergências: %d\n", "Galopante (consultas ordenadas):", tBinaria * 1e9 / qtdConsultas, tGalope * 1e9 / qtdConsultas, tBinaria / tGalope, erros);
+
+    // Conferência da busca galopante nas duas direções
+    erros = 0;
+    for (int i = 0; i < 100000; i++) {
+        long int k = A[0] + aleatorio() % (3 * n);
+        long int d = aleatorio() % n;
+        if (buscaGalopante(A, n, d, k) != buscaBinaria(A, 0, n - 1, k)) {
+            erros++;
+        }
+    }
+    printf("\nbuscaGalopante com dicas aleatórias: %d divergências.\n", erros);
+
+    // Fluxo ordenado sem tamanho conhecido
+    Fluxo f = {1000000};
+    printf("buscaIlimitada: 2999997 na posição %ld; 2999998 -> %ld\n", buscaIlimitada(elementoFluxo, &f, 2999997), buscaIlimitada(elementoFluxo, &f, 2999998));
+
+    // Libera a memória
+    free(A);
+    free(Q);
+    free(esperado);
+    free(obtido);
+
+    return 0;
+}
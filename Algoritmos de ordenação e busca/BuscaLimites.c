@@ -0,0 +1,178 @@
+// ## Limite Inferior, Limite Superior e Contagem por Intervalo ##
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+Obs.: a buscaBinaria retorna um índice qualquer em que o valor aparece (ou -1). Com valores repetidos, isso não responde "quantas chaves estão em [a, b)" nem "onde x deveria ser inserido". As funções abaixo respondem em O(log n):
+
+- lowerBound(x): primeiro índice i com A[i] >= x (posição de inserção de x antes dos iguais);
+- upperBound(x): primeiro índice i com A[i] > x (posição de inserção de x depois dos iguais);
+- equalRange(x): intervalo [lowerBound(x), upperBound(x)) com todas as cópias de x;
+- contaIntervalo(a, b): quantidade de chaves em [a, b) = lowerBound(b) - lowerBound(a).
+
+O meio é calculado como ini + (fim - ini) / 2. A forma (ini + fim) / 2 estoura quando ini + fim passa de INT_MAX, o que acontece com vetores de mais de 2^30 elementos.
+*/
+
+// Intervalo semiaberto [ini, fim)
+typedef struct Intervalo {
+    long int ini;
+    long int fim;
+} Intervalo;
+
+// ##################################################### //
+// INT
+
+// Primeiro índice com A[i] >= x (n se não houver)
+long int lowerBound (const int A[], long int n, int x) {
+    long int ini = 0;
+    long int fim = n; // Busca em [ini, fim)
+
+    while (ini < fim) {
+        long int meio = ini + (fim - ini) / 2;
+        if (A[meio] < x) {
+            ini = meio + 1;
+        }
+        else {
+            fim = meio;
+        }
+    }
+
+    return ini;
+}
+
+// Primeiro índice com A[i] > x (n se não houver)
+long int upperBound (const int A[], long int n, int x) {
+    long int ini = 0;
+    long int fim = n;
+
+    while (ini < fim) {
+        long int meio = ini + (fim - ini) / 2;
+        if (A[meio] <= x) {
+            ini = meio + 1;
+        }
+        else {
+            fim = meio;
+        }
+    }
+
+    return ini;
+}
+
+// Intervalo com todas as cópias de x (vazio se x não existe)
+Intervalo equalRange (const int A[], long int n, int x) {
+    Intervalo r;
+    r.ini = lowerBound(A, n, x);
+
+    // O limite superior só pode estar em [r.ini, n)
+    r.fim = r.ini + upperBound(A + r.ini, n - r.ini, x);
+
+    return r;
+}
+
+// Quantidade de chaves em [a, b)
+long int contaIntervalo (const int A[], long int n, int a, int b) {
+    if (b <= a) {
+        return 0;
+    }
+    return lowerBound(A, n, b) - lowerBound(A, n, a);
+}
+
+// ##################################################### //
+// LONG INT
+
+// Primeiro índice com A[i] >= x (n se não houver)
+long int lowerBoundLong (const long int A[], long int n, long int x) {
+    long int ini = 0;
+    long int fim = n;
+
+    while (ini < fim) {
+        long int meio = ini + (fim - ini) / 2;
+        if (A[meio] < x) {
+            ini = meio + 1;
+        }
+        else {
+            fim = meio;
+        }
+    }
+
+    return ini;
+}
+
+// Primeiro índice com A[i] > x (n se não houver)
+long int upperBoundLong (const long int A[], long int n, long int x) {
+    long int ini = 0;
+    long int fim = n;
+
+    while (ini < fim) {
+        long int meio = ini + (fim - ini) / 2;
+        if (A[meio] <= x) {
+            ini = meio + 1;
+        }
+        else {
+            fim = meio;
+        }
+    }
+
+    return ini;
+}
+
+// Intervalo com todas as cópias de x (vazio se x não existe)
+Intervalo equalRangeLong (const long int A[], long int n, long int x) {
+    Intervalo r;
+    r.ini = lowerBoundLong(A, n, x);
+    r.fim = r.ini + upperBoundLong(A + r.ini, n - r.ini, x);
+    return r;
+}
+
+// Quantidade de chaves em [a, b)
+long int contaIntervaloLong (const long int A[], long int n, long int a, long int b) {
+    if (b <= a) {
+        return 0;
+    }
+    return lowerBoundLong(A, n, b) - lowerBoundLong(A, n, a);
+}
+
+// Imprimindo o vetor
+void imprimeVetor (const int A[], long int n) {
+    printf("[");
+    for (long int i = 0; i < n; i++) {
+        if (i > 0) {printf(" ");}
+        printf("%d", A[i]);
+    }
+    printf("]");
+}
+
+int main () {
+    int A[] = {1, 2, 2, 2, 5, 7, 7, 9, 12, 12, 12, 12, 15};
+    long int n = sizeof(A) / sizeof(A[0]);
+
+    printf("## Limites e Contagem por Intervalo ##\n");
+    printf("Vetor: ");
+    imprimeVetor(A, n);
+    printf("\n\n");
+
+    int consultas[] = {0, 2, 6, 7, 12, 16};
+    int qtd = sizeof(consultas) / sizeof(consultas[0]);
+
+    for (int i = 0; i < qtd; i++) {
+        int x = consultas[i];
+        Intervalo r = equalRange(A, n, x);
+        printf("x = %2d: lowerBound = %2ld | upperBound = %2ld | ocorrências = %ld\n", x, lowerBound(A, n, x), upperBound(A, n, x), r.fim - r.ini);
+    }
+    printf("\n");
+
+    printf("Chaves em [2, 12): %ld\n", contaIntervalo(A, n, 2, 12));
+    printf("Chaves em [3, 7): %ld\n", contaIntervalo(A, n, 3, 7));
+    printf("Chaves em [0, 100): %ld\n\n", contaIntervalo(A, n, 0, 100));
+
+    // Matrículas (long int) com repetições
+    long int matriculas[] = {20230000001, 20230000001, 20230000050, 20240000007, 20240000007, 20240000007, 20250000100};
+    long int m = sizeof(matriculas) / sizeof(matriculas[0]);
+
+    Intervalo r = equalRangeLong(matriculas, m, 20240000007);
+    printf("Matrícula 20240000007 nas posições [%ld, %ld)\n", r.ini, r.fim);
+    printf("Matrículas de 2024 (em [20240000000, 20250000000)): %ld\n", contaIntervaloLong(matriculas, m, 20240000000, 20250000000));
+
+    return 0;
+}
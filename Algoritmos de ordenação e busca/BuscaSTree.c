@@ -0,0 +1,355 @@
+// ## Árvore B Estática (S-tree) com SIMD para Vetores Ordenados ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#define B 16 // Chaves int por nó: 16 * 4 bytes = 1 linha de cache
+#define BL 8 // Chaves long por nó: 8 * 8 bytes = 1 linha de cache
+#define tamPadrao (1 << 22)
+#define qtdConsultas 2000000
+
+/*
+Obs.: a busca binária lê cerca de log2(n) linhas de cache por consulta. A S-tree reorganiza o vetor ordenado em uma árvore B estática e implícita: cada nó é uma linha de cache com B chaves ordenadas, e os filhos do nó k ficam em k * (B + 1) + i + 1 (sem ponteiros). Uma consulta desce log_(B+1)(n) nós, ou seja, cerca de log17(n) falhas de cache para int.
+
+Dentro do nó, a posição do primeiro elemento >= x é a quantidade de chaves menores que x. Com AVX2 ela sai de duas comparações de 8 inteiros (ou 4 longs), um movemask e uma contagem de bits, sem laço e sem desvio. Compile com -mavx2 (ou -march=native); sem AVX2, o mesmo cálculo é feito com um laço escalar.
+
+Os nós incompletos são preenchidos com o maior valor do tipo (INT_MAX / LONG_MAX). A estrutura é somente leitura: é construída uma vez a partir do vetor ordenado.
+*/
+
+// S-tree de int
+typedef struct STree {
+    int (*nos)[B]; // Nós de B chaves, alinhados à linha de cache
+    int qtdNos;
+    int n; // Quantidade de chaves reais
+    int maior; // Maior chave real (para diferenciar do preenchimento)
+} STree;
+
+// S-tree de long int
+typedef struct STreeLong {
+    long int (*nos)[BL];
+    int qtdNos;
+    int n;
+    long int maior;
+} STreeLong;
+
+// Busca binária tradicional (BuscaBinaria.c), com o tamanho como parâmetro
+int buscaBinaria (int A[], int n, int k) {
+    int ini = 0;
+    int fim = n - 1;
+    int meio;
+
+    while (ini <= fim) {
+        meio = ini + (fim - ini) / 2;
+        if (k < A[meio]) {
+            fim = meio - 1;
+        }
+        else if (k > A[meio]) {
+            ini = meio + 1;
+        }
+        else {
+            return meio;
+        }
+    }
+
+    return -1;
+}
+
+// Índice do i-ésimo filho do nó k
+int filho (int k, int i, int b) {
+    return k * (b + 1) + i + 1;
+}
+
+// ##################################################### //
+// S-TREE DE INT
+
+// Preenche os nós em ordem (subárvore 0, chave 0, subárvore 1, chave 1, ...)
+int preencheSTree (STree *t, const int A[], int k, int pos) {
+    if (k < t->qtdNos) {
+        for (int i = 0; i < B; i++) {
+            pos = preencheSTree(t, A, filho(k, i, B), pos);
+            t->nos[k][i] = (pos < t->n) ? A[pos++] : INT_MAX;
+        }
+        pos = preencheSTree(t, A, filho(k, B, B), pos);
+    }
+    return pos;
+}
+
+// Constrói a S-tree a partir de um vetor ordenado com n > 0 elementos
+STree *init_stree (const int A[], int n) {
+    STree *t = (STree *)malloc(sizeof(STree));
+
+    // Verifica a alocação de memória
+    if (t == NULL) {
+        printf("Não foi possível alocar memória para a S-tree.\n");
+        return NULL;
+    }
+
+    t->n = n;
+    t->qtdNos = (n + B - 1) / B;
+    t->maior = A[n - 1];
+    t->nos = aligned_alloc(64, sizeof(int) * B * (size_t)t->qtdNos);
+
+    // Verifica a alocação de memória
+    if (t->nos == NULL) {
+        printf("Não foi possível alocar memória para os nós da S-tree.\n");
+        free(t);
+        return NULL;
+    }
+
+    preencheSTree(t, A, 0, 0);
+
+    return t;
+}
+
+// Quantidade de chaves do nó menores que x (posição do primeiro elemento >= x)
+static inline int rankNo (const int no[B], int x) {
+#ifdef __AVX2__
+    __m256i alvo = _mm256_set1_epi32(x);
+    __m256i a = _mm256_load_si256((const __m256i *)no);
+    __m256i b = _mm256_load_si256((const __m256i *)(no + 8));
+
+    // Cada faixa vale -1 onde x > chave
+    __m256i ma = _mm256_cmpgt_epi32(alvo, a);
+    __m256i mb = _mm256_cmpgt_epi32(alvo, b);
+
+    unsigned int mascara = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(ma)) |
+                           ((unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(mb)) << 8);
+
+    return __builtin_popcount(mascara);
+#else
+    int r = 0;
+    for (int i = 0; i < B; i++) {
+        r += (no[i] < x);
+    }
+    return r;
+#endif
+}
+
+// Retorna o menor elemento >= x (INT_MAX se não houver)
+int lowerBoundSTree (const STree *t, int x) {
+    int k = 0;
+    int res = INT_MAX;
+
+    while (k < t->qtdNos) {
+        int i = rankNo(t->nos[k], x);
+
+        if (i < B) {
+            res = t->nos[k][i];
+        }
+
+        k = filho(k, i, B);
+    }
+
+    return res;
+}
+
+// Retorna 1 se x está no vetor, 0 caso contrário
+int buscaSTree (const STree *t, int x) {
+    return x <= t->maior && lowerBoundSTree(t, x) == x;
+}
+
+// Libera a memória da S-tree
+void liberaSTree (STree *t) {
+    free(t->nos);
+    free(t);
+}
+
+// ##################################################### //
+// S-TREE DE LONG INT
+
+// Preenche os nós em ordem
+int preencheSTreeLong (STreeLong *t, const long int A[], int k, int pos) {
+    if (k < t->qtdNos) {
+        for (int i = 0; i < BL; i++) {
+            pos = preencheSTreeLong(t, A, filho(k, i, BL), pos);
+            t->nos[k][i] = (pos < t->n) ? A[pos++] : LONG_MAX;
+        }
+        pos = preencheSTreeLong(t, A, filho(k, BL, BL), pos);
+    }
+    return pos;
+}
+
+// Constrói a S-tree a partir de um vetor ordenado com n > 0 elementos
+STreeLong *init_streeLong (const long int A[], int n) {
+    STreeLong *t = (STreeLong *)malloc(sizeof(STreeLong));
+
+    // Verifica a alocação de memória
+    if (t == NULL) {
+        printf("Não foi possível alocar memória para a S-tree.\n");
+        return NULL;
+    }
+
+    t->n = n;
+    t->qtdNos = (n + BL - 1) / BL;
+    t->maior = A[n - 1];
+    t->nos = aligned_alloc(64, sizeof(long int) * BL * (size_t)t->qtdNos);
+
+    // Verifica a alocação de memória
+    if (t->nos == NULL) {
+        printf("Não foi possível alocar memória para os nós da S-tree.\n");
+        free(t);
+        return NULL;
+    }
+
+    preencheSTreeLong(t, A, 0, 0);
+
+    return t;
+}
+
+// Quantidade de chaves do nó menores que x
+static inline int rankNoLong (const long int no[BL], long int x) {
+#ifdef __AVX2__
+    __m256i alvo = _mm256_set1_epi64x(x);
+    __m256i a = _mm256_load_si256((const __m256i *)no);
+    __m256i b = _mm256_load_si256((const __m256i *)(no + 4));
+
+    __m256i ma = _mm256_cmpgt_epi64(alvo, a);
+    __m256i mb = _mm256_cmpgt_epi64(alvo, b);
+
+    unsigned int mascara = (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(ma)) |
+                           ((unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(mb)) << 4);
+
+    return __builtin_popcount(mascara);
+#else
+    int r = 0;
+    for (int i = 0; i < BL; i++) {
+        r += (no[i] < x);
+    }
+    return r;
+#endif
+}
+
+// Retorna o menor elemento >= x (LONG_MAX se não houver)
+long int lowerBoundSTreeLong (const STreeLong *t, long int x) {
+    int k = 0;
+    long int res = LONG_MAX;
+
+    while (k < t->qtdNos) {
+        int i = rankNoLong(t->nos[k], x);
+
+        if (i < BL) {
+            res = t->nos[k][i];
+        }
+
+        k = filho(k, i, BL);
+    }
+
+    return res;
+}
+
+// Retorna 1 se x está no vetor, 0 caso contrário
+int buscaSTreeLong (const STreeLong *t, long int x) {
+    return x <= t->maior && lowerBoundSTreeLong(t, x) == x;
+}
+
+// Libera a memória da S-tree
+void liberaSTreeLong (STreeLong *t) {
+    free(t->nos);
+    free(t);
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main (int argc, char *argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : tamPadrao;
+
+    if (n <= 0) {
+        printf("Tamanho inválido.\n");
+        return 1;
+    }
+
+    printf("## S-tree ##\n");
+#ifdef __AVX2__
+    printf("Busca nos nós: AVX2\n");
+#else
+    printf("Busca nos nós: escalar (compile com -mavx2 para SIMD)\n");
+#endif
+    printf("Vetor com %d chaves, %d consultas.\n\n", n, qtdConsultas);
+
+    int *A = (int *)malloc(sizeof(int) * n);
+    long int *L = (long int *)malloc(sizeof(long int) * n);
+    int *Q = (int *)malloc(sizeof(int) * qtdConsultas);
+
+    // Verifica a alocação de memória
+    if (A == NULL || L == NULL || Q == NULL) {
+        printf("Não foi possível alocar memória para os vetores.\n");
+        return 1;
+    }
+
+    // Chaves pares; as matrículas (long) ficam acima de 2^32
+    for (int i = 0; i < n; i++) {
+        A[i] = 2 * i;
+        L[i] = 20000000000L + 2L * i;
+    }
+
+    srand(3);
+    for (int i = 0; i < qtdConsultas; i++) {
+        long int r = ((long int)rand() << 16) ^ rand();
+        Q[i] = (int)(r % (2L * n + 2)); // Inclui consultas acima da maior chave
+    }
+
+    STree *t = init_stree(A, n);
+    STreeLong *tl = init_streeLong(L, n);
+
+    if (t == NULL || tl == NULL) {
+        return 1;
+    }
+
+    // Conferência com a busca binária
+    int erros = 0;
+    for (int i = 0; i < qtdConsultas; i++) {
+        int esperado = buscaBinaria(A, n, Q[i]) != -1;
+
+        if (buscaSTree(t, Q[i]) != esperado || buscaSTreeLong(tl, 20000000000L + Q[i]) != esperado) {
+            erros++;
+        }
+    }
+    printf("Conferência: %d divergências.\n\n", erros);
+
+    // Medição
+    double inicio;
+    long int soma = 0;
+
+    inicio = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        soma += buscaBinaria(A, n, Q[i]) != -1;
+    }
+    double tBinaria = agora() - inicio;
+    printf("buscaBinaria:     %6.1f ns/consulta (%ld encontradas)\n", tBinaria * 1e9 / qtdConsultas, soma);
+
+    soma = 0;
+    inicio = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        soma += buscaSTree(t, Q[i]);
+    }
+    double tSTree = agora() - inicio;
+    printf("buscaSTree:       %6.1f ns/consulta (%ld encontradas, %.2fx)\n", tSTree * 1e9 / qtdConsultas, soma, tBinaria / tSTree);
+
+    soma = 0;
+    inicio = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        soma += buscaSTreeLong(tl, 20000000000L + Q[i]);
+    }
+    double tSTreeLong = agora() - inicio;
+    printf("buscaSTreeLong:   %6.1f ns/consulta (%ld encontradas, %.2fx)\n", tSTreeLong * 1e9 / qtdConsultas, soma, tBinaria / tSTreeLong);
+
+    // Libera a memória
+    liberaSTree(t);
+    liberaSTreeLong(tl);
+    free(A);
+    free(L);
+    free(Q);
+
+    return 0;
+}
@@ -0,0 +1,415 @@
+// ## Interseção, União e Diferença de Conjuntos Ordenados ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define limiarGalope 32 // Razão de tamanhos a partir da qual a interseção galopa
+
+/*
+Obs.: os conjuntos são vetores ordenados de int sem repetição (ex.: matrículas inscritas em uma disciplina). Fazer a interseção chamando buscaBinaria para cada elemento custa O(m log n) sem aproveitar que as consultas também estão ordenadas. Há duas estratégias melhores, e a função intersecao escolhe entre elas pela razão dos tamanhos:
+
+1) Tamanhos parecidos: intercalação linear (como o merge do MergeSort.c), O(m + n). Com SSE2, blocos de 4 elementos de cada lado são comparados de uma vez (4 comparações com rotações do bloco de B cobrem os 16 pares), e avança o bloco com o menor último elemento.
+
+2) Tamanhos muito diferentes: para cada elemento do vetor menor, galopa no maior a partir da última posição encontrada (saltos 1, 2, 4, ... e busca binária no último salto). O custo é O(m log(n / m)).
+
+A interseção de k conjuntos começa pelo menor e intersecta o resultado parcial com os demais em ordem crescente de tamanho, de forma que o resultado parcial só diminui.
+*/
+
+// Primeiro índice i >= ini com A[i] >= k (n se não houver), galopando a partir de ini
+int galopa (const int A[], int n, int ini, int k) {
+    if (ini >= n || A[ini] >= k) {
+        return ini;
+    }
+
+    // A[base] < k; dobra o salto até A[base + salto] >= k
+    int base = ini;
+    int salto = 1;
+    while (base + salto < n && A[base + salto] < k) {
+        base += salto;
+        salto *= 2;
+    }
+
+    int fim = (base + salto < n) ? base + salto : n;
+
+    // Busca binária (lower bound) em (base, fim]
+    int esq = base + 1;
+    while (esq < fim) {
+        int meio = esq + (fim - esq) / 2;
+        if (A[meio] < k) {
+            esq = meio + 1;
+        }
+        else {
+            fim = meio;
+        }
+    }
+
+    return esq;
+}
+
+// Interseção por intercalação escalar. Retorna o tamanho de C
+int intersecaoLinear (const int A[], int na, const int B[], int nb, int C[]) {
+    int i = 0, j = 0, k = 0;
+
+    while (i < na && j < nb) {
+        if (A[i] < B[j]) {
+            i++;
+        }
+        else if (A[i] > B[j]) {
+            j++;
+        }
+        else {
+            C[k++] = A[i];
+            i++;
+            j++;
+        }
+    }
+
+    return k;
+}
+
+// Interseção por intercalação em blocos de 4 (SSE2). Retorna o tamanho de C
+int intersecaoSIMD (const int A[], int na, const int B[], int nb, int C[]) {
+    int i = 0, j = 0, k = 0;
+
+#ifdef __SSE2__
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(A + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(B + j));
+
+        // Compara cada elemento de A com os 4 de B (rotações de vb)
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+
+        // Bit b da máscara ligado: A[i + b] está no bloco de B
+        int mascara = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        while (mascara) {
+            int b = __builtin_ctz(mascara);
+            C[k++] = A[i + b];
+            mascara &= mascara - 1;
+        }
+
+        // Avança o bloco cujo último elemento é menor (ou os dois)
+        int ultA = A[i + 3];
+        int ultB = B[j + 3];
+        i += (ultA <= ultB) * 4;
+        j += (ultB <= ultA) * 4;
+    }
+#endif
+
+    // Resto escalar
+    return k + intersecaoLinear(A + i, na - i, B + j, nb - j, C + k);
+}
+
+// Interseção galopando no maior vetor (B) para cada elemento do menor (A). Retorna o tamanho de C
+int intersecaoGalope (const int A[], int na, const int B[], int nb, int C[]) {
+    int j = 0, k = 0;
+
+    for (int i = 0; i < na && j < nb; i++) {
+        j = galopa(B, nb, j, A[i]);
+        if (j < nb && B[j] == A[i]) {
+            C[k++] = A[i];
+            j++;
+        }
+    }
+
+    return k;
+}
+
+// Interseção adaptativa. C deve ter espaço para min(na, nb) elementos. Retorna o tamanho de C
+int intersecao (const int A[], int na, const int B[], int nb, int C[]) {
+    // Garante que A é o menor
+    if (na > nb) {
+        const int *T = A; A = B; B = T;
+        int t = na; na = nb; nb = t;
+    }
+
+    if (na == 0) {
+        return 0;
+    }
+
+    if (nb / na >= limiarGalope) {
+        return intersecaoGalope(A, na, B, nb, C);
+    }
+
+    return intersecaoSIMD(A, na, B, nb, C);
+}
+
+// União (sem repetições). C deve ter espaço para na + nb elementos. Retorna o tamanho de C
+int uniao (const int A[], int na, const int B[], int nb, int C[]) {
+    int i = 0, j = 0, k = 0;
+
+    while (i < na && j < nb) {
+        if (A[i] < B[j]) {
+            C[k++] = A[i++];
+        }
+        else if (A[i] > B[j]) {
+            C[k++] = B[j++];
+        }
+        else {
+            C[k++] = A[i];
+            i++;
+            j++;
+        }
+    }
+
+    while (i < na) {
+        C[k++] = A[i++];
+    }
+    while (j < nb) {
+        C[k++] = B[j++];
+    }
+
+    return k;
+}
+
+// Diferença A \ B. C deve ter espaço para na elementos. Retorna o tamanho de C
+int diferenca (const int A[], int na, const int B[], int nb, int C[]) {
+    int j = 0, k = 0;
+
+    // A muito menor que B: galopa em B para cada elemento de A
+    if (na > 0 && nb / na >= limiarGalope) {
+        for (int i = 0; i < na; i++) {
+            j = galopa(B, nb, j, A[i]);
+            if (j >= nb || B[j] != A[i]) {
+                C[k++] = A[i];
+            }
+        }
+        return k;
+    }
+
+    // Intercalação linear
+    int i = 0;
+    while (i < na) {
+        while (j < nb && B[j] < A[i]) {
+            j++;
+        }
+        if (j >= nb || B[j] != A[i]) {
+            C[k++] = A[i];
+        }
+        i++;
+    }
+
+    return k;
+}
+
+// Interseção de k conjuntos. C deve ter espaço para o tamanho do menor. Retorna o tamanho de C
+int intersecaoK (const int *conjuntos[], const int tamanhos[], int k, int C[]) {
+    if (k == 0) {
+        return 0;
+    }
+
+    // Ordena os índices dos conjuntos por tamanho (insertion sort; k é pequeno)
+    int *ordem = (int *)malloc(sizeof(int) * k);
+
+    // Verifica a alocação de memória
+    if (ordem == NULL) {
+        printf("Não foi possível alocar memória para a interseção.\n");
+        return 0;
+    }
+
+    for (int i = 0; i < k; i++) {
+        int j = i - 1;
+        while (j >= 0 && tamanhos[ordem[j]] > tamanhos[i]) {
+            ordem[j + 1] = ordem[j];
+            j--;
+        }
+        ordem[j + 1] = i;
+    }
+
+    // Buffer auxiliar do tamanho do menor conjunto
+    int *aux = (int *)malloc(sizeof(int) * (tamanhos[ordem[0]] + 1));
+
+    // Verifica a alocação de memória
+    if (aux == NULL) {
+        printf("Não foi possível alocar memória para a interseção.\n");
+        free(ordem);
+        return 0;
+    }
+
+    // Resultado parcial começa como o menor conjunto
+    int n = tamanhos[ordem[0]];
+    for (int i = 0; i < n; i++) {
+        C[i] = conjuntos[ordem[0]][i];
+    }
+
+    // Intersecta o parcial com os demais, alternando entre C e aux (o bloco SIMD não pode escrever onde lê)
+    int *atual = C;
+    int *proximo = aux;
+    for (int i = 1; i < k && n > 0; i++) {
+        n = intersecao(atual, n, conjuntos[ordem[i]], tamanhos[ordem[i]], proximo);
+        int *t = atual; atual = proximo; proximo = t;
+    }
+
+    if (atual != C) {
+        for (int i = 0; i < n; i++) {
+            C[i] = atual[i];
+        }
+    }
+
+    free(ordem);
+    free(aux);
+    return n;
+}
+
+// Busca binária tradicional (BuscaBinaria.c), com o tamanho como parâmetro
+int buscaBinaria (const int A[], int n, int k) {
+    int ini = 0;
+    int fim = n - 1;
+
+    while (ini <= fim) {
+        int meio = ini + (fim - ini) / 2;
+        if (k < A[meio]) {
+            fim = meio - 1;
+        }
+        else if (k > A[meio]) {
+            ini = meio + 1;
+        }
+        else {
+            return meio;
+        }
+    }
+
+    return -1;
+}
+
+// Interseção como é feita hoje: buscaBinaria no maior para cada elemento do menor
+int intersecaoBuscaBinaria (const int A[], int na, const int B[], int nb, int C[]) {
+    int k = 0;
+    for (int i = 0; i < na; i++) {
+        if (buscaBinaria(B, nb, A[i]) != -1) {
+            C[k++] = A[i];
+        }
+    }
+    return k;
+}
+
+// ##################################################### //
+// DEMONSTRAÇÃO E MEDIÇÕES
+
+// Gera um conjunto ordenado com cerca de n elementos de [0, universo)
+int geraConjunto (int V[], int n, int universo) {
+    int k = 0;
+    for (int x = 0; x < universo && k < n; x++) {
+        // Sorteia x com probabilidade restante / faltam (amostragem sequencial)
+        if ((long int)rand() * (universo - x) < (long int)(n - k) * RAND_MAX) {
+            V[k++] = x;
+        }
+    }
+    return k;
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Mede a interseção por buscaBinaria e a adaptativa para dois tamanhos
+void mede (int na, int nb, int universo) {
+    int *A = (int *)malloc(sizeof(int) * na);
+    int *B = (int *)malloc(sizeof(int) * nb);
+    int *C = (int *)malloc(sizeof(int) * (na < nb ? na : nb));
+    int *D = (int *)malloc(sizeof(int) * (na < nb ? na : nb));
+
+    // Verifica a alocação de memória
+    if (A == NULL || B == NULL || C == NULL || D == NULL) {
+        printf("Não foi possível alocar memória para os conjuntos.\n");
+        return;
+    }
+
+    na = geraConjunto(A, na, universo);
+    nb = geraConjunto(B, nb, universo);
+
+    int repeticoes = 20;
+    double inicio = agora();
+    int nc = 0;
+    for (int r = 0; r < repeticoes; r++) {
+        nc = intersecaoBuscaBinaria(A, na, B, nb, C);
+    }
+    double tBinaria = (agora() - inicio) / repeticoes;
+
+    inicio = agora();
+    int nd = 0;
+    for (int r = 0; r < repeticoes; r++) {
+        nd = intersecao(A, na, B, nb, D);
+    }
+    double tAdaptativa = (agora() - inicio) / repeticoes;
+
+    int iguais = (nc == nd);
+    for (int i = 0; i < nc && iguais; i++) {
+        iguais = (C[i] == D[i]);
+    }
+
+    printf("|A| = %8d, |B| = %8d: buscaBinaria %8.3f ms | adaptativa (%s) %8.3f ms | %5.2fx | %d em comum%s\n", na, nb, tBinaria * 1e3, (nb / na >= limiarGalope) ? "galope" : "SIMD  ", tAdaptativa * 1e3, tBinaria / tAdaptativa, nd, iguais ? "" : " (DIVERGE)");
+
+    free(A);
+    free(B);
+    free(C);
+    free(D);
+}
+
+// Imprimindo o vetor
+void imprimeVetor (const int A[], int n) {
+    printf("[");
+    for (int i = 0; i < n; i++) {
+        if (i > 0) {printf(" ");}
+        printf("%d", A[i]);
+    }
+    printf("]\n");
+}
+
+int main () {
+    printf("## Conjuntos Ordenados ##\n");
+
+    int discA[] = {1, 3, 4, 7, 9, 12, 15, 18, 21, 30};
+    int discB[] = {2, 3, 7, 8, 9, 15, 21, 22, 31};
+    int discC[] = {3, 5, 7, 9, 21, 40};
+    int na = sizeof(discA) / sizeof(discA[0]);
+    int nb = sizeof(discB) / sizeof(discB[0]);
+    int nc = sizeof(discC) / sizeof(discC[0]);
+    int R[32];
+    int n;
+
+    printf("Disciplina A: ");
+    imprimeVetor(discA, na);
+    printf("Disciplina B: ");
+    imprimeVetor(discB, nb);
+    printf("Disciplina C: ");
+    imprimeVetor(discC, nc);
+
+    n = intersecao(discA, na, discB, nb, R);
+    printf("A e B: ");
+    imprimeVetor(R, n);
+
+    n = uniao(discA, na, discB, nb, R);
+    printf("A ou B: ");
+    imprimeVetor(R, n);
+
+    n = diferenca(discA, na, discB, nb, R);
+    printf("A sem B: ");
+    imprimeVetor(R, n);
+
+    const int *conjuntos[] = {discA, discB, discC};
+    int tamanhos[] = {na, nb, nc};
+    n = intersecaoK(conjuntos, tamanhos, 3, R);
+    printf("A, B e C: ");
+    imprimeVetor(R, n);
+    printf("\n");
+
+    // Medições: tamanhos parecidos e muito diferentes
+    srand(17);
+    mede(1000000, 1000000, 4000000);
+    mede(100000, 1000000, 4000000);
+    mede(1000, 1000000, 4000000);
+    mede(100, 4000000, 8000000);
+
+    return 0;
+}
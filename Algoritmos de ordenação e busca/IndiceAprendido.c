@@ -0,0 +1,421 @@
+// ## Índice Aprendido (Modelo Linear por Partes com Erro Máximo ε) ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define maxNiveis 16
+#define epsInterno 4 // Erro máximo dos níveis superiores (que são pequenos)
+#define tamPadrao 10000000
+#define qtdConsultas 2000000
+
+/*
+Obs.: em um vetor ordenado, a função chave -> posição é monótona. Se as chaves são regulares (como as matrículas), essa função é quase uma reta, e poucos segmentos de reta a aproximam com erro de no máximo ε posições. O índice guarda apenas esses segmentos (chave inicial, inclinação e posição inicial), ocupando poucos KB, no estilo do PGM-index:
+
+1) Construção: cada segmento começa em um ponto (x0, y0) e mantém o "cone" de inclinações que ainda mantêm todos os pontos seguintes a no máximo ε da reta. Quando um ponto novo esvazia o cone, o segmento é fechado e outro começa nele. É uma passada linear sobre o vetor.
+
+2) Níveis: as chaves iniciais dos segmentos formam um vetor ordenado menor, que é indexado da mesma forma, até sobrar um único segmento. A busca desce do topo: em cada nível, o modelo prevê a posição no nível de baixo e uma busca binária curta em [previsto - ε, previsto + ε] corrige o erro.
+
+3) Reconstrução incremental: alterar o vetor a partir de uma posição só invalida os segmentos daquela posição em diante. Em um acréscimo de matrículas no fim, só o último segmento é refeito, e os níveis superiores (pequenos) são reconstruídos.
+
+As chaves devem ser distintas.
+*/
+
+// Segmento de reta: posição prevista = pos + inclinacao * (k - chave)
+typedef struct Segmento {
+    long int chave; // Primeira chave coberta
+    double inclinacao;
+    long int pos; // Posição da primeira chave coberta
+} Segmento;
+
+// Um nível do índice: segmentos ajustados sobre um vetor de chaves
+typedef struct Nivel {
+    const long int *chaves; // Chaves indexadas por este nível
+    long int n;
+    Segmento *segs;
+    long int qtdSegs;
+    long int capSegs;
+    long int *chavesSegs; // Chaves iniciais dos segmentos (indexadas pelo nível de cima)
+} Nivel;
+
+// Estrutura do índice
+typedef struct IndiceAprendido {
+    Nivel niveis[maxNiveis]; // niveis[0] indexa o vetor de dados
+    int qtdNiveis;
+    int eps; // Erro máximo do nível 0
+} IndiceAprendido;
+
+// Busca binária tradicional (BuscaBinaria.c) em long int
+long int buscaBinaria (const long int A[], long int n, long int k) {
+    long int ini = 0;
+    long int fim = n - 1;
+
+    while (ini <= fim) {
+        long int meio = ini + (fim - ini) / 2;
+        if (k < A[meio]) {
+            fim = meio - 1;
+        }
+        else if (k > A[meio]) {
+            ini = meio + 1;
+        }
+        else {
+            return meio;
+        }
+    }
+
+    return -1;
+}
+
+// Primeiro índice em [ini, fim) com A[i] >= k (fim se não houver)
+long int lowerBoundJanela (const long int A[], long int ini, long int fim, long int k) {
+    while (ini < fim) {
+        long int meio = ini + (fim - ini) / 2;
+        if (A[meio] < k) {
+            ini = meio + 1;
+        }
+        else {
+            fim = meio;
+        }
+    }
+    return ini;
+}
+
+// Acrescenta um segmento ao nível. Retorna 0 em caso de falha
+int novoSegmento (Nivel *nv, long int chave, double inclinacao, long int pos) {
+    if (nv->qtdSegs == nv->capSegs) {
+        long int capNova = nv->capSegs ? nv->capSegs * 2 : 16;
+        Segmento *novo = (Segmento *)realloc(nv->segs, sizeof(Segmento) * capNova);
+
+        // Verifica a alocação de memória
+        if (novo == NULL) {
+            printf("Não foi possível alocar memória para os segmentos.\n");
+            return 0;
+        }
+
+        nv->segs = novo;
+        nv->capSegs = capNova;
+    }
+
+    nv->segs[nv->qtdSegs].chave = chave;
+    nv->segs[nv->qtdSegs].inclinacao = inclinacao;
+    nv->segs[nv->qtdSegs].pos = pos;
+    nv->qtdSegs++;
+
+    return 1;
+}
+
+// Ajusta segmentos (cone que encolhe) sobre chaves[inicio..n). Retorna 0 em caso de falha
+int ajustaSegmentos (Nivel *nv, long int inicio, int eps) {
+    const long int *X = nv->chaves;
+    long int i = inicio;
+
+    while (i < nv->n) {
+        long int x0 = X[i];
+        long int y0 = i;
+        double minIncl = 0; // Inclinações válidas: [minIncl, maxIncl]
+        double maxIncl = 1e300;
+
+        i++;
+        while (i < nv->n) {
+            double dx = (double)(X[i] - x0);
+            double dy = (double)(i - y0);
+            double lo = (dy - eps) / dx;
+            double hi = (dy + eps) / dx;
+
+            // O ponto não cabe no cone: fecha o segmento
+            if (lo > maxIncl || hi < minIncl) {
+                break;
+            }
+
+            if (lo > minIncl) {
+                minIncl = lo;
+            }
+            if (hi < maxIncl) {
+                maxIncl = hi;
+            }
+            i++;
+        }
+
+        // Segmento de um ponto só (ou último): inclinação qualquer dentro do cone
+        double inclinacao = (maxIncl == 1e300) ? 0 : (minIncl + maxIncl) / 2;
+
+        if (!novoSegmento(nv, x0, inclinacao, y0)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Posição prevista para k no segmento s do nível, limitada ao trecho coberto por s
+long int prevePosicao (const Nivel *nv, long int s, long int k) {
+    const Segmento *seg = &nv->segs[s];
+    long int fimSeg = (s + 1 < nv->qtdSegs) ? nv->segs[s + 1].pos : nv->n; // Posição seguinte ao trecho
+
+    double p = seg->pos + seg->inclinacao * (double)(k - seg->chave);
+
+    if (p < seg->pos) {
+        return seg->pos;
+    }
+    if (p > fimSeg) {
+        return fimSeg;
+    }
+    return (long int)p;
+}
+
+// Lower bound de k nas chaves do nível, usando o segmento s e a janela de erro eps
+long int lowerBoundNivel (const Nivel *nv, long int s, long int k, int eps) {
+    long int p = prevePosicao(nv, s, k);
+    long int ini = p - eps - 1;
+    long int fim = p + eps + 2;
+
+    if (ini < 0) {
+        ini = 0;
+    }
+    if (fim > nv->n) {
+        fim = nv->n;
+    }
+
+    return lowerBoundJanela(nv->chaves, ini, fim, k);
+}
+
+// Libera os níveis a partir de "de"
+void liberaNiveis (IndiceAprendido *idx, int de) {
+    for (int l = de; l < idx->qtdNiveis; l++) {
+        free(idx->niveis[l].segs);
+        free(idx->niveis[l].chavesSegs);
+        idx->niveis[l].segs = NULL;
+        idx->niveis[l].chavesSegs = NULL;
+        idx->niveis[l].qtdSegs = 0;
+        idx->niveis[l].capSegs = 0;
+    }
+}
+
+// Reconstrói os níveis superiores a partir dos segmentos do nível 0. Retorna 0 em caso de falha
+int constroiNiveisSuperiores (IndiceAprendido *idx) {
+    liberaNiveis(idx, 1);
+    free(idx->niveis[0].chavesSegs);
+    idx->niveis[0].chavesSegs = NULL;
+    idx->qtdNiveis = 1;
+
+    int l = 0;
+    while (idx->niveis[l].qtdSegs > 1 && l + 1 < maxNiveis) {
+        Nivel *nv = &idx->niveis[l];
+
+        // Chaves iniciais dos segmentos deste nível
+        nv->chavesSegs = (long int *)malloc(sizeof(long int) * nv->qtdSegs);
+
+        // Verifica a alocação de memória
+        if (nv->chavesSegs == NULL) {
+            printf("Não foi possível alocar memória para os níveis do índice.\n");
+            return 0;
+        }
+
+        for (long int s = 0; s < nv->qtdSegs; s++) {
+            nv->chavesSegs[s] = nv->segs[s].chave;
+        }
+
+        Nivel *acima = &idx->niveis[l + 1];
+        acima->chaves = nv->chavesSegs;
+        acima->n = nv->qtdSegs;
+        acima->segs = NULL;
+        acima->qtdSegs = 0;
+        acima->capSegs = 0;
+        acima->chavesSegs = NULL;
+
+        if (!ajustaSegmentos(acima, 0, epsInterno)) {
+            return 0;
+        }
+
+        l++;
+        idx->qtdNiveis++;
+    }
+
+    return 1;
+}
+
+// Constrói o índice sobre o vetor ordenado A (que não é copiado)
+IndiceAprendido *init_indice (const long int A[], long int n, int eps) {
+    IndiceAprendido *idx = (IndiceAprendido *)calloc(1, sizeof(IndiceAprendido));
+
+    // Verifica a alocação de memória
+    if (idx == NULL) {
+        printf("Não foi possível alocar memória para o índice.\n");
+        return NULL;
+    }
+
+    idx->eps = eps;
+    idx->qtdNiveis = 1;
+    idx->niveis[0].chaves = A;
+    idx->niveis[0].n = n;
+
+    if (!ajustaSegmentos(&idx->niveis[0], 0, eps) || !constroiNiveisSuperiores(idx)) {
+        liberaNiveis(idx, 0);
+        free(idx);
+        return NULL;
+    }
+
+    return idx;
+}
+
+// Reconstrói o índice depois que A mudou a partir da posição "pos" (A pode ter sido realocado e ter novo tamanho n)
+int reconstroiDesde (IndiceAprendido *idx, const long int A[], long int n, long int pos) {
+    Nivel *nv = &idx->niveis[0];
+
+    // Descarta os segmentos que cobrem posições >= pos (o que contém pos também)
+    while (nv->qtdSegs > 0 && nv->segs[nv->qtdSegs - 1].pos >= pos) {
+        nv->qtdSegs--;
+    }
+
+    long int inicio = 0;
+    if (nv->qtdSegs > 0) {
+        nv->qtdSegs--; // Segmento que contém pos
+        inicio = nv->segs[nv->qtdSegs].pos;
+    }
+
+    nv->chaves = A;
+    nv->n = n;
+
+    return ajustaSegmentos(nv, inicio, idx->eps) && constroiNiveisSuperiores(idx);
+}
+
+// Primeiro índice de A com A[i] >= k
+long int lowerBoundIndice (const IndiceAprendido *idx, long int k) {
+    long int s = 0; // O nível do topo tem um único segmento
+
+    for (int l = idx->qtdNiveis - 1; l > 0; l--) {
+        const Nivel *nv = &idx->niveis[l];
+        long int p = lowerBoundNivel(nv, s, k, epsInterno);
+
+        // Segmento do nível de baixo: o último com chave inicial <= k
+        s = (p < nv->n && nv->chaves[p] == k) ? p : p - 1;
+        if (s < 0) {
+            s = 0;
+        }
+    }
+
+    if (idx->niveis[0].qtdSegs == 0) {
+        return 0;
+    }
+
+    return lowerBoundNivel(&idx->niveis[0], s, k, idx->eps);
+}
+
+// Retorna o índice de k em A ou -1
+long int buscaIndice (const IndiceAprendido *idx, long int k) {
+    long int i = lowerBoundIndice(idx, k);
+    return (i < idx->niveis[0].n && idx->niveis[0].chaves[i] == k) ? i : -1;
+}
+
+// Memória usada pelo índice, em bytes (sem contar o vetor de dados)
+long int memoriaIndice (const IndiceAprendido *idx) {
+    long int bytes = sizeof(IndiceAprendido);
+    for (int l = 0; l < idx->qtdNiveis; l++) {
+        bytes += idx->niveis[l].qtdSegs * (long int)sizeof(Segmento);
+        if (idx->niveis[l].chavesSegs != NULL) {
+            bytes += idx->niveis[l].qtdSegs * (long int)sizeof(long int);
+        }
+    }
+    return bytes;
+}
+
+// Libera a memória do índice
+void liberaIndice (IndiceAprendido *idx) {
+    liberaNiveis(idx, 0);
+    free(idx);
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Número aleatório de 62 bits
+long int aleatorio () {
+    return ((long int)rand() << 31) ^ rand();
+}
+
+// Confere o índice com a busca binária em consultas aleatórias
+int confere (const IndiceAprendido *idx, const long int A[], long int n) {
+    int erros = 0;
+    for (int i = 0; i < 200000; i++) {
+        long int k = (i % 2) ? A[aleatorio() % n] : A[0] - 5 + aleatorio() % (A[n - 1] - A[0] + 10);
+        if (buscaIndice(idx, k) != buscaBinaria(A, n, k)) {
+            erros++;
+        }
+    }
+    return erros;
+}
+
+int main (int argc, char *argv[]) {
+    long int n = (argc > 1) ? atol(argv[1]) : tamPadrao;
+    int eps = (argc > 2) ? atoi(argv[2]) : 32;
+    long int acrescimo = n / 10;
+
+    if (n <= 0 || eps <= 0) {
+        printf("Parâmetros inválidos.\n");
+        return 1;
+    }
+
+    long int *A = (long int *)malloc(sizeof(long int) * (n + acrescimo));
+    long int *Q = (long int *)malloc(sizeof(long int) * qtdConsultas);
+
+    // Verifica a alocação de memória
+    if (A == NULL || Q == NULL) {
+        printf("Não foi possível alocar memória para os vetores.\n");
+        return 1;
+    }
+
+    // Matrículas quase uniformes
+    srand(13);
+    A[0] = 20000000000L;
+    for (long int i = 1; i < n + acrescimo; i++) {
+        A[i] = A[i - 1] + 1 + rand() % 199;
+    }
+
+    printf("## Índice Aprendido ##\n");
+
+    double inicio = agora();
+    IndiceAprendido *idx = init_indice(A, n, eps);
+    if (idx == NULL) {
+        return 1;
+    }
+    printf("%ld chaves, eps = %d: %ld segmentos, %d níveis, %.1f KB, construído em %.0f ms.\n", n, eps, idx->niveis[0].qtdSegs, idx->qtdNiveis, memoriaIndice(idx) / 1024.0, (agora() - inicio) * 1e3);
+    printf("Conferência: %d divergências.\n\n", confere(idx, A, n));
+
+    // Medição
+    for (int i = 0; i < qtdConsultas; i++) {
+        Q[i] = (i % 2) ? A[aleatorio() % n] : A[0] + aleatorio() % (A[n - 1] - A[0] + 1);
+    }
+
+    long int achou = 0;
+    inicio = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        achou += buscaBinaria(A, n, Q[i]) != -1;
+    }
+    double tBinaria = agora() - inicio;
+    printf("buscaBinaria:  %6.1f ns/consulta (%ld encontradas)\n", tBinaria * 1e9 / qtdConsultas, achou);
+
+    achou = 0;
+    inicio = agora();
+    for (int i = 0; i < qtdConsultas; i++) {
+        achou += buscaIndice(idx, Q[i]) != -1;
+    }
+    double tIndice = agora() - inicio;
+    printf("buscaIndice:   %6.1f ns/consulta (%ld encontradas, %.2fx)\n\n", tIndice * 1e9 / qtdConsultas, achou, tBinaria / tIndice);
+
+    // Acréscimo de matrículas no fim: reconstrução incremental
+    inicio = agora();
+    reconstroiDesde(idx, A, n + acrescimo, n);
+    printf("Acréscimo de %ld chaves: reconstrução incremental em %.0f ms, %ld segmentos.\n", acrescimo, (agora() - inicio) * 1e3, idx->niveis[0].qtdSegs);
+    printf("Conferência: %d divergências.\n", confere(idx, A, n + acrescimo));
+
+    // Libera a memória
+    liberaIndice(idx);
+    free(A);
+    free(Q);
+
+    return 0;
+}
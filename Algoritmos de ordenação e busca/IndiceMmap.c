@@ -0,0 +1,312 @@
+// ## Índice Ordenado em Arquivo Mapeado em Memória (mmap) ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define versaoIndice 1
+#define chavesPorBloco 512 // 512 * 8 bytes = 4 KB = 1 página por bloco
+#define alinhamento 4096
+#define tamPadrao 10000000
+
+/*
+Obs.: em vez de ler um arquivo texto e reordenar as chaves a cada inicialização, o vetor ordenado é gravado uma vez em formato binário e depois mapeado com mmap somente leitura. A busca lê direto das páginas do arquivo (sem cópia), a abertura não depende do tamanho do arquivo (as páginas só são lidas quando tocadas) e processos diferentes que mapeiam o mesmo arquivo compartilham o page cache.
+
+Formato do arquivo (inteiros little-endian, como na memória):
+- Cabeçalho (64 bytes): mágica "CCINDICE", versão, chaves por bloco, quantidade de chaves, quantidade de cercas e deslocamentos das cercas e das chaves;
+- Cercas (fence pointers): a primeira chave de cada bloco de chavesPorBloco chaves. São poucas (n / 512) e ficam quentes no cache;
+- Chaves: o vetor ordenado de long int, alinhado à página, para que cada bloco ocupe exatamente uma página.
+
+A busca faz uma busca binária nas cercas para escolher o bloco e depois a buscaBinaria dentro do bloco: uma única página do vetor de chaves é tocada por consulta.
+*/
+
+// Cabeçalho do arquivo
+typedef struct Cabecalho {
+    char magica[8]; // "CCINDICE"
+    uint32_t versao;
+    uint32_t tamBloco; // Chaves por bloco
+    uint64_t n; // Quantidade de chaves
+    uint64_t qtdCercas;
+    uint64_t offsetCercas; // Deslocamento das cercas no arquivo
+    uint64_t offsetChaves; // Deslocamento das chaves no arquivo
+    uint64_t reservado[2];
+} Cabecalho;
+
+// Índice aberto
+typedef struct IndiceMmap {
+    void *mapa; // Início do mapeamento
+    size_t tamanho; // Tamanho do mapeamento
+    const Cabecalho *cab;
+    const long int *cercas;
+    const long int *chaves;
+    long int n;
+    long int qtdCercas;
+} IndiceMmap;
+
+// Busca binária (BuscaBinaria.c) em long int, dentro de [ini, fim]
+long int buscaBinaria (const long int A[], long int ini, long int fim, long int k) {
+    while (ini <= fim) {
+        long int meio = ini + (fim - ini) / 2;
+        if (k < A[meio]) {
+            fim = meio - 1;
+        }
+        else if (k > A[meio]) {
+            ini = meio + 1;
+        }
+        else {
+            return meio;
+        }
+    }
+
+    return -1;
+}
+
+// Escreve exatamente "tam" bytes. Retorna 0 em caso de falha
+int escreveTudo (int fd, const void *buf, size_t tam) {
+    const char *p = (const char *)buf;
+    while (tam > 0) {
+        ssize_t escritos = write(fd, p, tam);
+        if (escritos <= 0) {
+            return 0;
+        }
+        p += escritos;
+        tam -= (size_t)escritos;
+    }
+    return 1;
+}
+
+// Grava o vetor ordenado A no formato do índice. Retorna 0 em caso de falha
+int gravaIndice (const char *caminho, const long int A[], long int n) {
+    Cabecalho cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, "CCINDICE", 8);
+    cab.versao = versaoIndice;
+    cab.tamBloco = chavesPorBloco;
+    cab.n = (uint64_t)n;
+    cab.qtdCercas = (uint64_t)((n + chavesPorBloco - 1) / chavesPorBloco);
+    cab.offsetCercas = sizeof(Cabecalho);
+    cab.offsetChaves = (cab.offsetCercas + cab.qtdCercas * sizeof(long int) + alinhamento - 1) / alinhamento * alinhamento;
+
+    // Primeira chave de cada bloco
+    long int *cercas = (long int *)malloc(sizeof(long int) * (cab.qtdCercas + 1));
+
+    // Verifica a alocação de memória
+    if (cercas == NULL) {
+        printf("Não foi possível alocar memória para as cercas.\n");
+        return 0;
+    }
+
+    for (uint64_t b = 0; b < cab.qtdCercas; b++) {
+        cercas[b] = A[b * chavesPorBloco];
+    }
+
+    // Grava em um arquivo temporário e renomeia: leitores nunca veem um arquivo pela metade
+    char temporario[4096];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+
+    int fd = open(temporario, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        printf("Não foi possível criar o arquivo %s.\n", temporario);
+        free(cercas);
+        return 0;
+    }
+
+    size_t preenchimento = cab.offsetChaves - cab.offsetCercas - cab.qtdCercas * sizeof(long int);
+    char *zeros = (char *)calloc(1, preenchimento + 1);
+
+    int ok = zeros != NULL &&
+             escreveTudo(fd, &cab, sizeof(cab)) &&
+             escreveTudo(fd, cercas, cab.qtdCercas * sizeof(long int)) &&
+             escreveTudo(fd, zeros, preenchimento) &&
+             escreveTudo(fd, A, (size_t)n * sizeof(long int)) &&
+             fsync(fd) == 0;
+
+    close(fd);
+    free(zeros);
+    free(cercas);
+
+    if (!ok || rename(temporario, caminho) != 0) {
+        printf("Não foi possível gravar o índice em %s.\n", caminho);
+        unlink(temporario);
+        return 0;
+    }
+
+    return 1;
+}
+
+// Abre o índice com mmap somente leitura. Retorna NULL em caso de falha
+IndiceMmap *abreIndice (const char *caminho) {
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        printf("Não foi possível abrir o arquivo %s.\n", caminho);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Cabecalho)) {
+        printf("Arquivo %s inválido.\n", caminho);
+        close(fd);
+        return NULL;
+    }
+
+    void *mapa = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // O mapeamento continua válido depois de fechar o descritor
+
+    if (mapa == MAP_FAILED) {
+        printf("Não foi possível mapear o arquivo %s.\n", caminho);
+        return NULL;
+    }
+
+    const Cabecalho *cab = (const Cabecalho *)mapa;
+
+    // Valida o cabeçalho e os limites antes de confiar nos deslocamentos
+    // (limites por subtração e divisão: uma soma de deslocamento e tamanho pode dar a volta em 64 bits)
+    uint64_t tamanho = (uint64_t)st.st_size;
+    int valido = memcmp(cab->magica, "CCINDICE", 8) == 0 &&
+                 cab->versao == versaoIndice &&
+                 cab->tamBloco == chavesPorBloco &&
+                 cab->offsetCercas >= sizeof(Cabecalho) &&
+                 cab->offsetCercas % sizeof(long int) == 0 &&
+                 cab->offsetChaves % alinhamento == 0 &&
+                 cab->offsetCercas <= cab->offsetChaves &&
+                 cab->offsetChaves <= tamanho &&
+                 cab->qtdCercas <= (cab->offsetChaves - cab->offsetCercas) / sizeof(long int) &&
+                 cab->n <= (tamanho - cab->offsetChaves) / sizeof(long int) &&
+                 cab->qtdCercas == (cab->n + chavesPorBloco - 1) / chavesPorBloco;
+
+    if (!valido) {
+        printf("Cabeçalho do índice %s inválido ou de outra versão.\n", caminho);
+        munmap(mapa, (size_t)st.st_size);
+        return NULL;
+    }
+
+    IndiceMmap *idx = (IndiceMmap *)malloc(sizeof(IndiceMmap));
+
+    // Verifica a alocação de memória
+    if (idx == NULL) {
+        printf("Não foi possível alocar memória para o índice.\n");
+        munmap(mapa, (size_t)st.st_size);
+        return NULL;
+    }
+
+    idx->mapa = mapa;
+    idx->tamanho = (size_t)st.st_size;
+    idx->cab = cab;
+    idx->cercas = (const long int *)((const char *)mapa + cab->offsetCercas);
+    idx->chaves = (const long int *)((const char *)mapa + cab->offsetChaves);
+    idx->n = (long int)cab->n;
+    idx->qtdCercas = (long int)cab->qtdCercas;
+
+    // Acesso aleatório: o kernel não deve ler páginas à frente
+    madvise(mapa, idx->tamanho, MADV_RANDOM);
+
+    return idx;
+}
+
+// Retorna o índice de k no vetor do arquivo ou -1
+long int buscaIndice (const IndiceMmap *idx, long int k) {
+    if (idx->n == 0 || k < idx->cercas[0]) {
+        return -1;
+    }
+
+    // Último bloco cuja primeira chave é <= k
+    long int ini = 0;
+    long int fim = idx->qtdCercas - 1;
+    while (ini < fim) {
+        long int meio = ini + (fim - ini + 1) / 2;
+        if (idx->cercas[meio] <= k) {
+            ini = meio;
+        }
+        else {
+            fim = meio - 1;
+        }
+    }
+
+    // buscaBinaria dentro do bloco (uma página)
+    long int iniBloco = ini * chavesPorBloco;
+    long int fimBloco = iniBloco + chavesPorBloco - 1;
+    if (fimBloco >= idx->n) {
+        fimBloco = idx->n - 1;
+    }
+
+    return buscaBinaria(idx->chaves, iniBloco, fimBloco, k);
+}
+
+// Desfaz o mapeamento
+void fechaIndice (IndiceMmap *idx) {
+    munmap(idx->mapa, idx->tamanho);
+    free(idx);
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main (int argc, char *argv[]) {
+    const char *caminho = (argc > 1) ? argv[1] : "matriculas.idx";
+    long int n = (argc > 2) ? atol(argv[2]) : tamPadrao;
+
+    if (n <= 0) {
+        printf("Tamanho inválido.\n");
+        return 1;
+    }
+
+    printf("## Índice em Arquivo Mapeado ##\n");
+
+    // Gera e grava as matrículas ordenadas
+    long int *A = (long int *)malloc(sizeof(long int) * n);
+
+    // Verifica a alocação de memória
+    if (A == NULL) {
+        printf("Não foi possível alocar memória para as matrículas.\n");
+        return 1;
+    }
+
+    srand(19);
+    A[0] = 20000000000L;
+    for (long int i = 1; i < n; i++) {
+        A[i] = A[i - 1] + 1 + rand() % 99;
+    }
+
+    double inicio = agora();
+    if (!gravaIndice(caminho, A, n)) {
+        free(A);
+        return 1;
+    }
+    printf("Gravação de %ld chaves em %s: %.0f ms\n", n, caminho, (agora() - inicio) * 1e3);
+
+    // Abertura: independe do tamanho do arquivo
+    inicio = agora();
+    IndiceMmap *idx = abreIndice(caminho);
+    if (idx == NULL) {
+        free(A);
+        return 1;
+    }
+    printf("Abertura com mmap: %.3f ms (%.1f MB mapeados, %ld cercas)\n\n", (agora() - inicio) * 1e3, idx->tamanho / 1048576.0, idx->qtdCercas);
+
+    // Conferência com a buscaBinaria no vetor em memória
+    int erros = 0;
+    int qtd = 1000000;
+    inicio = agora();
+    for (int i = 0; i < qtd; i++) {
+        long int k = A[0] - 10 + (((long int)rand() << 16) ^ rand()) % (A[n - 1] - A[0] + 20);
+        if (buscaIndice(idx, k) != buscaBinaria(A, 0, n - 1, k)) {
+            erros++;
+        }
+    }
+    printf("%d consultas conferidas em %.0f ms: %d divergências.\n", qtd, (agora() - inicio) * 1e3, erros);
+
+    fechaIndice(idx);
+    free(A);
+
+    return 0;
+}
@@ -2,10 +2,41 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-// Constantes e variáveis globais
-int tamTab = 5; // Tamanho inicial da tabela
-#define ocupMax 0.80 // Taxa de ocupação máxima da tabela
+// Constantes
+#define ocupMaxPadrao 0.80 // Taxa de ocupação máxima padrão da tabela
+#define capMaxima (1 << 30) // Maior capacidade (potência de 2 que ainda cabe em int)
+#define versaoSnapshot 2
+#define alinhamento 4096
+#define tamLote 256 // Matrículas com hash calculado de uma vez nas operações em lote
+#define distPrefetch 16 // Quantas matrículas à frente a posição inicial é pedida à memória
+#define faixasHist 16 // Faixas dos histogramas de instrumentação (faixa k: de 2^k a 2^(k+1) - 1)
+#define contadoresBloco 128 // Contadores de 4 bits por bloco do filtro (um bloco = uma linha de cache de 64 bytes)
+#define contadorMax 15 // Contador saturado: não é mais decrementado
+
+// Políticas de hash (escolha na compilação com -DfuncaoHash=HASH_...)
+#define HASH_FIBONACCI 1
+#define HASH_MULTSHIFT 2
+#define HASH_WYHASH 3
+#ifndef funcaoHash
+#define funcaoHash HASH_FIBONACCI
+#endif
+
+/*
+Obs.: capacidade sempre potência de 2 (índice por máscara, sem o módulo de 64 bits), com a matrícula misturada antes pela política de hash escolhida na compilação.
+Lote: insere_lote e busca_lote calculam os hashes de um bloco e pedem as posições com prefetch, com várias faltas de cache em andamento ao mesmo tempo.
+Capacidade: cada tabela tem a sua ConfigHash; reserve(n) dimensiona de uma vez e a tabela encolhe quando a ocupação fica abaixo de ocupMin.
+Snapshot: salvaSnapshot grava o vetor como está e carregaSnapshot o mapeia com mmap privado, sem reinserir.
+Instrumentação: Estatisticas com histogramas de sondagens (amostrados), redimensionamentos e agrupamentos; exportaJSON escreve tudo em JSON.
+Filtro de Bloom: opcional (ativaFiltro), em blocos de uma linha de cache com contadores de 4 bits, descarta a maioria das buscas de ausentes.
+*/
 
 // Tipos enumerados
 typedef enum status {
@@ -15,25 +46,139 @@ typedef enum status {
     TABELA_CHEIA = -3
 } status;
 
+// Configuração de capacidade de uma tabela
+typedef struct ConfigHash {
+    int capInicial; // Capacidade inicial e mínima (arredondada para potência de 2)
+    float ocupMin; // Abaixo desta taxa de ocupação a tabela encolhe (0 desativa)
+    float ocupMax; // Acima desta taxa de ocupação a tabela cresce
+    int fatorCrescimento; // Multiplicador da capacidade ao crescer (potência de 2)
+} ConfigHash;
+
+// Instrumentação de uma tabela
+typedef struct Estatisticas {
+    unsigned int periodoAmostra; // Registra 1 a cada periodoAmostra operações (potência de 2, 0 desativa)
+    unsigned int contador; // Operações desde a última amostra
+    long int sondagensInsere[faixasHist]; // Histograma de posições sondadas por operação
+    long int sondagensBusca[faixasHist];
+    long int sondagensRemove[faixasHist];
+    long int agrupamentos[faixasHist]; // Histograma dos tamanhos dos agrupamentos primários (coletaAgrupamentos)
+    int maiorAgrupamento;
+    long int redimensionamentos;
+    double tempoRedimensionamentos; // Segundos
+    double maiorRedimensionamento; // Segundos
+    long int reinsercoes; // Reinserções feitas pelo reorganiza
+    long int rejeitadasFiltro; // Buscas respondidas pelo filtro sem consultar a tabela
+} Estatisticas;
+
+// Filtro de Bloom em blocos com contadores de 4 bits: as k posições de uma matrícula ficam em um bloco de 64 bytes
+// (uma falta de cache por consulta), e os contadores permitem retirar as matrículas removidas
+typedef struct FiltroBloom {
+    uint64_t *blocos; // nBlocos * 8 palavras (16 contadores por palavra)
+    int nBlocos;
+    int k; // Contadores por matrícula
+    double fpAlvo; // Taxa de falsos positivos pedida
+    size_t orcamento; // Limite de memória em bytes (0 = sem limite)
+} FiltroBloom;
+
 // Estrutura da Hash (endereçamento fechado)
 typedef struct HashTable {
     long int *matriculas; // Array para armazenar os números de matrícula
     int qtdMat; // Quantidade de matrículas cadastradas
     int capacidade; // Quantidade de espaços disponíveis
+    ConfigHash config;
+    int mapeada; // 1 se matriculas aponta para um snapshot mapeado com mmap
+    void *mapa; // Início do mapeamento (se mapeada)
+    size_t tamMapa; // Tamanho do mapeamento (se mapeada)
+    Estatisticas est;
+    FiltroBloom *filtro; // NULL se o filtro estiver desativado
 } HashTable;
 
+// Cabeçalho do arquivo de snapshot (64 bytes)
+typedef struct CabecalhoSnapshot {
+    char magica[8]; // "CCHASHTB"
+    uint32_t versao;
+    uint32_t funcao; // Política de hash (funcaoHash): o vetor só vale para a política que o gravou
+    uint64_t capacidade;
+    uint64_t qtdMat;
+    uint64_t checksum; // Do cabeçalho (com este campo zerado) e das posições
+    uint64_t offsetMatriculas; // Deslocamento do vetor no arquivo (alinhado à página)
+    ConfigHash config; // 16 bytes
+} CabecalhoSnapshot;
+
 // Cabeçalho
-HashTable *init_hash ();
+ConfigHash configPadrao ();
+ConfigHash normalizaConfig (ConfigHash config);
+HashTable *init_hash (ConfigHash config);
+int reserve (HashTable *tabela, long int n);
+void encolhe (HashTable *tabela);
 unsigned int hash (int capacidade, long int matricula);
 unsigned int ProbingLinear (int capacidade, unsigned int index, int i);
+unsigned int posiciona (long int *matriculas, int capacidade, long int matricula);
 int insere (HashTable *tabela, long int matricula);
 void redimensiona (HashTable *tabela);
+void redimensionaPara (HashTable *tabela, int capacidadeNova);
+int insere_lote (HashTable *tabela, long int matriculas[], int n, int resultados[]);
+void busca_lote (HashTable *tabela, long int matriculas[], int n, int resultados[]);
 int busca (HashTable *tabela, long int matricula);
 long int removeMat (HashTable *tabela, long int matricula);
 void reorganiza(HashTable *tabela, int probeIndex);
+int salvaSnapshot (HashTable *tabela, const char *caminho);
+HashTable *carregaSnapshot (const char *caminho, int verifica);
+void liberaHash (HashTable *tabela);
+void amostragem (HashTable *tabela, unsigned int periodo);
+void zeraEstatisticas (HashTable *tabela);
+void coletaAgrupamentos (HashTable *tabela);
+void exportaJSON (HashTable *tabela, FILE *saida);
+int ativaFiltro (HashTable *tabela, double fpAlvo, size_t orcamento);
+void desativaFiltro (HashTable *tabela);
+int reconstroiFiltro (HashTable *tabela);
+void adicionaFiltro (FiltroBloom *filtro, long int matricula);
+void retiraFiltro (FiltroBloom *filtro, long int matricula);
+int talvezContem (FiltroBloom *filtro, long int matricula);
+double agora ();
+
+// Configuração padrão: 8 posições, ocupação entre 0.20 e 0.80, dobra ao crescer
+ConfigHash configPadrao () {
+    ConfigHash config = {8, 0.20, ocupMaxPadrao, 2};
+    return config;
+}
+
+// Menor potência de 2 maior ou igual a n
+int potenciaDe2 (int n) {
+    int p = 1;
+    while (p < n) {
+        p *= 2;
+    }
+    return p;
+}
+
+// Ajusta a configuração: potências de 2 e ocupMin abaixo da ocupação logo após crescer
+// (também usada no carregaSnapshot, que não pode confiar na configuração do arquivo)
+ConfigHash normalizaConfig (ConfigHash config) {
+    if (config.capInicial > capMaxima) {
+        config.capInicial = capMaxima;
+    }
+    if (config.fatorCrescimento > capMaxima) {
+        config.fatorCrescimento = capMaxima;
+    }
+    config.capInicial = potenciaDe2(config.capInicial < 2 ? 2 : config.capInicial);
+    config.fatorCrescimento = potenciaDe2(config.fatorCrescimento < 2 ? 2 : config.fatorCrescimento);
+
+    // Comparações negadas para que NaN também seja substituído
+    if (!(config.ocupMax > 0 && config.ocupMax < 1)) {
+        config.ocupMax = ocupMaxPadrao;
+    }
+    if (!(config.ocupMin >= 0 && config.ocupMin < config.ocupMax / config.fatorCrescimento)) {
+        config.ocupMin = config.ocupMax / config.fatorCrescimento / 2;
+    }
+
+    return config;
+}
 
 // Inicializa a tabela
-HashTable *init_hash () {
+HashTable *init_hash (ConfigHash config) {
+    config = normalizaConfig(config);
+
     // Aloca memória para a tabela
     HashTable *tabela = (HashTable *)malloc(sizeof(HashTable));
     
@@ -44,7 +189,7 @@ HashTable *init_hash () {
     }
 
     // Aloca memória para as matrículas da tabela   
-    tabela->matriculas = (long int *)malloc(sizeof(long int) * tamTab);
+    tabela->matriculas = (long int *)malloc(sizeof(long int) * config.capInicial);
 
     // Verifica a alocação de memória
     if (tabela->matriculas == NULL) {
@@ -53,36 +198,101 @@ HashTable *init_hash () {
     }
 
     // Inicializa a tabela com valores inválidos
-    for (int i = 0; i < tamTab; i++) {
+    for (int i = 0; i < config.capInicial; i++) {
         tabela->matriculas[i] = -1;
     }
 
-    tabela->capacidade = tamTab;
+    tabela->capacidade = config.capInicial;
     tabela->qtdMat = 0;
+    tabela->config = config;
+    tabela->mapeada = 0;
+    tabela->mapa = NULL;
+    tabela->tamMapa = 0;
+    tabela->est.periodoAmostra = 1;
+    zeraEstatisticas(tabela);
+    tabela->filtro = NULL;
 
     return tabela;
 }
 
-// Função hash: aplica módulo 20 para determinar os índices
+// Hash de Fibonacci: os "bits" bits mais altos de matricula * 2^64/φ
+unsigned int hashFibonacci (long int matricula, int bits) {
+    return (unsigned int)(((uint64_t)matricula * 11400714819323198485ull) >> (64 - bits));
+}
+
+// Multiply-shift: os "bits" bits mais altos de a * matricula + b (a ímpar)
+unsigned int hashMultShift (long int matricula, int bits) {
+    return (unsigned int)(((uint64_t)matricula * 0xBF58476D1CE4E5B9ull + 0x94D049BB133111EBull) >> (64 - bits));
+}
+
+// Mistura do wyhash: xor das metades do produto de 128 bits
+uint64_t mistura (uint64_t a, uint64_t b) {
+    __uint128_t produto = (__uint128_t)a * b;
+    return (uint64_t)(produto >> 64) ^ (uint64_t)produto;
+}
+
+// Estilo wyhash: duas rodadas de mistura com as constantes do wyhash
+unsigned int hashWy (long int matricula, int bits) {
+    uint64_t h = mistura((uint64_t)matricula ^ 0xA0761D6478BD642Full, (uint64_t)matricula ^ 0xE7037ED1A0B428DBull);
+    h = mistura(h ^ 0xA0761D6478BD642Full, 0x8EBC6AF09C88C6E3ull);
+    return (unsigned int)(h >> (64 - bits));
+}
+
+// Função hash: aplica a política escolhida, com capacidade = 2^bits
+// (as três usam os bits altos de uma multiplicação; a máscara sozinha só aproveitaria os bits baixos da matrícula)
 unsigned int hash (int capacidade, long int matricula) {
-    return matricula % capacidade;
+    int bits = __builtin_ctz(capacidade);
+#if funcaoHash == HASH_MULTSHIFT
+    return hashMultShift(matricula, bits);
+#elif funcaoHash == HASH_WYHASH
+    return hashWy(matricula, bits);
+#else
+    return hashFibonacci(matricula, bits);
+#endif
 }
 
-// Calcula um novo índice em caso de colisão
+// Calcula um novo índice em caso de colisão (capacidade potência de 2: máscara em vez de módulo)
 unsigned int ProbingLinear (int capacidade, unsigned int index, int i) {
-    return (index + i) % capacidade;
+    return (index + i) & (capacidade - 1);
+}
+
+// Grava a matrícula na primeira posição vazia da sondagem, sem estatísticas, filtro nem redimensionamento
+// (redimensionaPara e reorganiza: a matrícula não está no vetor e há posição vazia). Retorna a posição
+unsigned int posiciona (long int *matriculas, int capacidade, long int matricula) {
+    unsigned int index = hash(capacidade, matricula);
+    while (matriculas[index] != -1) {
+        index = ProbingLinear(capacidade, index, 1);
+    }
+    matriculas[index] = matricula;
+    return index;
+}
+
+// Faixa do histograma de um valor >= 1 (floor(log2(valor)), limitada à última faixa): 1, 2-3, 4-7, ...
+// Registrar uma operação é um incremento
+int faixa (long int valor) {
+    int k = 63 - __builtin_clzl((unsigned long)valor);
+    return k < faixasHist ? k : faixasHist - 1;
+}
+
+// Registra no histograma as posições sondadas por uma operação, se ela for amostrada (1 a cada periodoAmostra)
+void registraSondagem (HashTable *tabela, long int histograma[], int sondagens) {
+    if (tabela->est.periodoAmostra == 0 || (++tabela->est.contador & (tabela->est.periodoAmostra - 1)) != 0) {
+        return;
+    }
+    histograma[faixa(sondagens)]++;
 }
 
 // Função para inserir uma matrícula na hash table
 int insere (HashTable *tabela, long int matricula) {  
-    unsigned int index = hash(tabela->capacidade, matricula);
-
     // Verifica se a tabela está cheia
     float txOcup = (float)tabela->qtdMat / tabela->capacidade;
-    if (txOcup >= ocupMax) {
+    if (txOcup >= tabela->config.ocupMax) {
         redimensiona(tabela);
     }
 
+    // Índice calculado depois do redimensionamento, com a capacidade atual
+    unsigned int index = hash(tabela->capacidade, matricula);
+
     // Probing Linear para gerenciamento de colisões
     for (int i = 0; i < tabela->capacidade; i++) {
         unsigned int probeIndex = ProbingLinear(tabela->capacidade, index, i);
@@ -91,27 +301,44 @@ int insere (HashTable *tabela, long int matricula) {
         if (tabela->matriculas[probeIndex] == -1) {
             tabela->matriculas[probeIndex] = matricula;
             tabela->qtdMat++;
+            if (tabela->filtro != NULL) {
+                adicionaFiltro(tabela->filtro, matricula);
+            }
+            registraSondagem(tabela, tabela->est.sondagensInsere, i + 1);
             return SUCESSO;
         }
 
         if (tabela->matriculas[probeIndex] == matricula) {
+            registraSondagem(tabela, tabela->est.sondagensInsere, i + 1);
             return EXISTE; // Matrícula já cadastrada
         }
     }
 
+    registraSondagem(tabela, tabela->est.sondagensInsere, tabela->capacidade);
     return TABELA_CHEIA;
 }
  
 // Redimensiona a tabela quando a txOcup chega no limite
 void redimensiona (HashTable *tabela) {
-    int capacidadeAntiga = tabela->capacidade;
-    int capacidadeNova;
-    
-    // Dobra a capacidade da tabela
-    capacidadeNova = capacidadeAntiga * 2;
-     
-    // Realoca espaço
-    long int *novaTabela = (long int *)realloc(tabela->matriculas, sizeof(long int) * capacidadeNova);
+    // Multiplica a capacidade da tabela pelo fator de crescimento (em 64 bits, limitado a capMaxima)
+    long int capacidadeNova = (long int)tabela->capacidade * tabela->config.fatorCrescimento;
+    if (capacidadeNova > capMaxima) {
+        capacidadeNova = capMaxima;
+    }
+
+    // Já na capacidade máxima: o insere segue até TABELA_CHEIA
+    if (capacidadeNova > tabela->capacidade) {
+        redimensionaPara(tabela, (int)capacidadeNova);
+    }
+}
+
+// Redimensiona a tabela para capacidadeNova posições (potência de 2, maior ou menor que a atual)
+void redimensionaPara (HashTable *tabela, int capacidadeNova) {
+    double inicio = agora();
+
+    // Aloca o novo vetor. Redistribuir no próprio vetor (tirando e reinserindo cada elemento) pode abrir
+    // posições vazias no meio da sondagem de elementos já reinseridos e torná-los inalcançáveis
+    long int *novaTabela = (long int *)malloc(sizeof(long int) * capacidadeNova);
 
     // Verifica a alocação de memória
     if (novaTabela == NULL) {
@@ -119,50 +346,224 @@ void redimensiona (HashTable *tabela) {
         return;
     }
 
-    // Reinicializa os campos da tabela
-    tabela->matriculas = novaTabela;
-    tabela->capacidade = capacidadeNova;
-    tabela->qtdMat = 0;
-
-    // Inicializa os novos espaços da tabela com -1 (vazio)
-    for (int i = tabela->capacidade / 2; i < tabela->capacidade; i++) {
-        tabela->matriculas[i] = -1;
+    // Inicializa a nova tabela com -1 (vazio)
+    for (int i = 0; i < capacidadeNova; i++) {
+        novaTabela[i] = -1;
     }
 
     // Re-hash dos elementos existentes (redistribuição)
-    for (int i = 0; i < capacidadeAntiga; i++) {
+    for (int i = 0; i < tabela->capacidade; i++) {
         if (tabela->matriculas[i] != -1) {
-            long int matricula = tabela->matriculas[i]; // Guarda a matrícula
-            tabela->matriculas[i] = -1; // Remove o elemento temporariamente
-            insere(tabela, matricula); // Reinsere o elemento
+            posiciona(novaTabela, capacidadeNova, tabela->matriculas[i]);
         }
     }
+
+    // Libera o vetor antigo (se veio de um snapshot, desfaz o mapeamento)
+    if (tabela->mapeada) {
+        munmap(tabela->mapa, tabela->tamMapa);
+        tabela->mapeada = 0;
+    }
+    else {
+        free(tabela->matriculas);
+    }
+    tabela->matriculas = novaTabela;
+    tabela->capacidade = capacidadeNova;
+
+    // O filtro é dimensionado pela capacidade: acompanha o redimensionamento
+    if (tabela->filtro != NULL) {
+        reconstroiFiltro(tabela);
+    }
+
+    double tempo = agora() - inicio;
+    tabela->est.redimensionamentos++;
+    tabela->est.tempoRedimensionamentos += tempo;
+    if (tempo > tabela->est.maiorRedimensionamento) {
+        tabela->est.maiorRedimensionamento = tempo;
+    }
 }
 
-// Função para buscar uma matrícula na hash table
-int busca (HashTable *tabela, long int matricula) {
+// Garante espaço para n matrículas sem redimensionamentos. Retorna 0 em caso de falha
+int reserve (HashTable *tabela, long int n) {
+    long int capacidade = tabela->capacidade;
+    while (n > capacidade * tabela->config.ocupMax && capacidade < capMaxima) {
+        capacidade *= 2;
+    }
+
+    // Nem a capacidade máxima comporta n matrículas
+    if (n > capacidade * tabela->config.ocupMax) {
+        return 0;
+    }
+
+    if (capacidade != tabela->capacidade) {
+        redimensionaPara(tabela, (int)capacidade);
+    }
+
+    return tabela->capacidade == capacidade;
+}
+
+// Encolhe a tabela se a ocupação ficou abaixo de ocupMin
+void encolhe (HashTable *tabela) {
+    float txOcup = (float)tabela->qtdMat / tabela->capacidade;
+    if (txOcup >= tabela->config.ocupMin || tabela->capacidade <= tabela->config.capInicial) {
+        return;
+    }
+
+    // Menor capacidade em que a ocupação fica no meio do intervalo [ocupMin, ocupMax], para que inserções e
+    // remoções perto de um dos limites não fiquem encolhendo e crescendo a tabela
+    float ocupAlvo = (tabela->config.ocupMin + tabela->config.ocupMax) / 2;
+    int capacidade = tabela->config.capInicial;
+    while (tabela->qtdMat > capacidade * ocupAlvo) {
+        capacidade *= 2;
+    }
+
+    if (capacidade < tabela->capacidade) {
+        redimensionaPara(tabela, capacidade);
+    }
+}
+
+// Localiza uma matrícula e registra as posições sondadas no histograma da operação
+int localiza (HashTable *tabela, long int matricula, long int histograma[]) {
     unsigned int index = hash(tabela->capacidade, matricula);
 
     // Rehash com Probing Linear para buscar a matrícula pelo index
-    for (int i = 0; i < tabela->capacidade; i++) {
+    int i;
+    for (i = 0; i < tabela->capacidade; i++) {
         unsigned int probeIndex = ProbingLinear(tabela->capacidade, index, i);
 
         // Matrícula encontrada
         if (tabela->matriculas[probeIndex] == matricula) {
+            registraSondagem(tabela, histograma, i + 1);
             return probeIndex; 
         }
 
         // Matrícula não cadastrada
         if (tabela->matriculas[probeIndex] == -1) {
+            i++;
             break; // Posição vazia
         }
     }
 
+    registraSondagem(tabela, histograma, i);
     return NAO_EXISTE; // Matrícula não encontrada
 }
 
+// Função para buscar uma matrícula na hash table
+int busca (HashTable *tabela, long int matricula) {
+    // O filtro descarta a maioria das ausentes com um único acesso
+    if (tabela->filtro != NULL && !talvezContem(tabela->filtro, matricula)) {
+        tabela->est.rejeitadasFiltro++;
+        return NAO_EXISTE;
+    }
+    return localiza(tabela, matricula, tabela->est.sondagensBusca);
+}
+
+// Insere n matrículas de uma vez. resultados[i] (se não for NULL) recebe SUCESSO ou EXISTE. Retorna a quantidade inserida
+// As operações em lote não entram nas estatísticas, para não pôr um desvio a mais no laço com prefetch
+int insere_lote (HashTable *tabela, long int matriculas[], int n, int resultados[]) {
+    // Dimensiona a tabela uma única vez para o lote inteiro
+    // Sem memória para crescer: insere uma a uma (o insere tenta redimensionar de novo)
+    if (!reserve(tabela, (long int)tabela->qtdMat + n)) {
+        int inseridas = 0;
+        for (int i = 0; i < n; i++) {
+            int r = insere(tabela, matriculas[i]);
+            inseridas += (r == SUCESSO);
+            if (resultados != NULL) {
+                resultados[i] = r;
+            }
+        }
+        return inseridas;
+    }
+
+    unsigned int indices[tamLote];
+    int inseridas = 0;
+
+    for (int ini = 0; ini < n; ini += tamLote) {
+        int qtd = (n - ini < tamLote) ? n - ini : tamLote;
+
+        // Hash do bloco inteiro e pedido antecipado das primeiras posições
+        for (int i = 0; i < qtd; i++) {
+            indices[i] = hash(tabela->capacidade, matriculas[ini + i]);
+        }
+        for (int i = 0; i < qtd && i < distPrefetch; i++) {
+            __builtin_prefetch(&tabela->matriculas[indices[i]], 1);
+        }
+
+        for (int i = 0; i < qtd; i++) {
+            if (i + distPrefetch < qtd) {
+                __builtin_prefetch(&tabela->matriculas[indices[i + distPrefetch]], 1);
+            }
+
+            // Probing Linear a partir da posição já calculada (a ocupação já foi garantida acima)
+            long int matricula = matriculas[ini + i];
+            unsigned int probeIndex = indices[i];
+            int r = SUCESSO;
+            while (tabela->matriculas[probeIndex] != -1) {
+                if (tabela->matriculas[probeIndex] == matricula) {
+                    r = EXISTE; // Matrícula já cadastrada
+                    break;
+                }
+                probeIndex = ProbingLinear(tabela->capacidade, probeIndex, 1);
+            }
+            if (r == SUCESSO) {
+                tabela->matriculas[probeIndex] = matricula;
+                tabela->qtdMat++;
+                inseridas++;
+                if (tabela->filtro != NULL) {
+                    adicionaFiltro(tabela->filtro, matricula);
+                }
+            }
+            if (resultados != NULL) {
+                resultados[ini + i] = r;
+            }
+        }
+    }
+
+    return inseridas;
+}
+
+// Busca n matrículas de uma vez. resultados[i] recebe o índice da matrícula ou NAO_EXISTE
+void busca_lote (HashTable *tabela, long int matriculas[], int n, int resultados[]) {
+    unsigned int indices[tamLote];
+
+    for (int ini = 0; ini < n; ini += tamLote) {
+        int qtd = (n - ini < tamLote) ? n - ini : tamLote;
+
+        // Hash do bloco inteiro e pedido antecipado das primeiras posições
+        for (int i = 0; i < qtd; i++) {
+            indices[i] = hash(tabela->capacidade, matriculas[ini + i]);
+        }
+        for (int i = 0; i < qtd && i < distPrefetch; i++) {
+            __builtin_prefetch(&tabela->matriculas[indices[i]]);
+        }
+
+        for (int i = 0; i < qtd; i++) {
+            if (i + distPrefetch < qtd) {
+                __builtin_prefetch(&tabela->matriculas[indices[i + distPrefetch]]);
+            }
+
+            // Probing Linear a partir da posição já calculada
+            long int matricula = matriculas[ini + i];
+            unsigned int probeIndex = indices[i];
+            resultados[ini + i] = NAO_EXISTE;
+            if (tabela->filtro != NULL && !talvezContem(tabela->filtro, matricula)) {
+                continue;
+            }
+            for (int j = 0; j < tabela->capacidade; j++) {
+                if (tabela->matriculas[probeIndex] == matricula) {
+                    resultados[ini + i] = probeIndex; // Matrícula encontrada
+                    break;
+                }
+                if (tabela->matriculas[probeIndex] == -1) {
+                    break; // Posição vazia
+                }
+                probeIndex = ProbingLinear(tabela->capacidade, probeIndex, 1);
+            }
+        }
+    }
+}
+
 long int removeMat (HashTable *tabela, long int matricula) {
-    int probeIndex = busca(tabela, matricula);
+    int probeIndex = localiza(tabela, matricula, tabela->est.sondagensRemove);
 
     // Matrícula não encontrada
     if (probeIndex == NAO_EXISTE) {
@@ -171,13 +572,18 @@ long int removeMat (HashTable *tabela, long int matricula) {
 
     // Matrícula encontrada
     tabela->matriculas[probeIndex] = -1; // Remove a matrícula
-    int qtdMat_Inicial = tabela->qtdMat; // Guarda a qtd de elementos antes da remoção
+    if (tabela->filtro != NULL) {
+        retiraFiltro(tabela->filtro, matricula);
+    }
+
+    // Atualiza a qtd de matrículas
+    tabela->qtdMat--;
 
     // Reorganiza os elementos deslocados
     reorganiza(tabela, probeIndex);
 
-    // Atualiza a qtd de matrículas na tabela
-    tabela->qtdMat = qtdMat_Inicial - 1;
+    // Devolve memória se a ocupação ficou baixa
+    encolhe(tabela);
 
     return matricula;
 }
@@ -214,10 +620,11 @@ long int removeMat (HashTable *tabela, long int matricula) {
 }*/
 
 void reorganiza (HashTable *tabela, int indexAtual) {
-    // Percorre as posições subsequentes ao elemento removido, de forma linear
-    for (int i = indexAtual + 1; i < tabela->capacidade; i++) {
+    // As matrículas só mudam de posição (posiciona não mexe no filtro nem redimensiona)
+    // Percorre as posições subsequentes ao elemento removido, de forma linear e circular (como o ProbingLinear)
+    for (int i = ProbingLinear(tabela->capacidade, indexAtual, 1); i != indexAtual; i = ProbingLinear(tabela->capacidade, i, 1)) {
         if (tabela->matriculas[i] == -1) {
-            break; // Não há mais elementos. A partir daqui, todos os índices estão vazios
+            break; // Fim do agrupamento: não há mais elementos deslocados
         }
         
         // Calcula o índice ideal deste elemento
@@ -227,12 +634,457 @@ void reorganiza (HashTable *tabela, int indexAtual) {
         if (i != indexIdeal) {
             long int matriculaMovida = tabela->matriculas[i]; // Guarda a matrícula
             tabela->matriculas[i] = -1; // Remove a matrícula temporariamente
-            tabela->qtdMat--; // Decrementa a qtd temporariamente
+            tabela->est.reinsercoes++;
             
-            // Reinsere a matrícula (se possível, no indexIdeal)
-            insere(tabela, matriculaMovida); 
+            // Reinsere a matrícula (se possível, no indexIdeal), sem passar pelo insere instrumentado
+            posiciona(tabela->matriculas, tabela->capacidade, matriculaMovida);
+        }
+    }
+}
+
+// Checksum do cabeçalho (sem o próprio checksum) e das posições (multiplicação e xor a cada 8 bytes)
+uint64_t checksum (const CabecalhoSnapshot *cabecalho, const long int *matriculas, int capacidade) {
+    CabecalhoSnapshot cab = *cabecalho;
+    cab.checksum = 0;
+
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < sizeof(cab); i += 8) {
+        uint64_t palavra;
+        memcpy(&palavra, (const char *)&cab + i, 8);
+        h = (h ^ palavra) * 1099511628211ull;
+    }
+    for (int i = 0; i < capacidade; i++) {
+        h = (h ^ (uint64_t)matriculas[i]) * 1099511628211ull;
+    }
+    return h;
+}
+
+// Escreve exatamente "tam" bytes. Retorna 0 em caso de falha
+int escreveTudo (int fd, const void *buf, size_t tam) {
+    const char *p = (const char *)buf;
+    while (tam > 0) {
+        ssize_t escritos = write(fd, p, tam);
+        if (escritos <= 0) {
+            return 0;
+        }
+        p += escritos;
+        tam -= (size_t)escritos;
+    }
+    return 1;
+}
+
+// Grava o snapshot da tabela. Retorna 0 em caso de falha
+int salvaSnapshot (HashTable *tabela, const char *caminho) {
+    CabecalhoSnapshot cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, "CCHASHTB", 8);
+    cab.versao = versaoSnapshot;
+    cab.funcao = funcaoHash;
+    cab.capacidade = (uint64_t)tabela->capacidade;
+    cab.qtdMat = (uint64_t)tabela->qtdMat;
+    cab.offsetMatriculas = alinhamento;
+    cab.config = tabela->config;
+    cab.checksum = checksum(&cab, tabela->matriculas, tabela->capacidade);
+
+    // Grava em um arquivo temporário e renomeia: quem carrega nunca vê um snapshot pela metade
+    char temporario[4096];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+
+    int fd = open(temporario, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        printf("Não foi possível criar o arquivo %s.\n", temporario);
+        return 0;
+    }
+
+    char *preenchimento = (char *)calloc(1, alinhamento - sizeof(cab));
+
+    int ok = preenchimento != NULL &&
+             escreveTudo(fd, &cab, sizeof(cab)) &&
+             escreveTudo(fd, preenchimento, alinhamento - sizeof(cab)) &&
+             escreveTudo(fd, tabela->matriculas, sizeof(long int) * tabela->capacidade) &&
+             fsync(fd) == 0;
+
+    close(fd);
+    free(preenchimento);
+
+    if (!ok || rename(temporario, caminho) != 0) {
+        printf("Não foi possível gravar o snapshot em %s.\n", caminho);
+        unlink(temporario);
+        return 0;
+    }
+
+    return 1;
+}
+
+// Carrega um snapshot com mmap privado (copy-on-write), sem reinserir. verifica = 1 confere o checksum. Retorna NULL em caso de falha
+// O vetor mapeado é usado direto como tabela->matriculas e as páginas só são lidas do disco quando tocadas. A primeira escrita
+// em uma página cria uma cópia só deste processo, então o arquivo nunca é alterado; redimensionaPara e liberaHash usam munmap
+HashTable *carregaSnapshot (const char *caminho, int verifica) {
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        printf("Não foi possível abrir o arquivo %s.\n", caminho);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CabecalhoSnapshot)) {
+        printf("Arquivo %s inválido.\n", caminho);
+        close(fd);
+        return NULL;
+    }
+
+    // Privado e com escrita: as páginas alteradas viram cópias deste processo
+    void *mapa = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); // O mapeamento continua válido depois de fechar o descritor
+
+    if (mapa == MAP_FAILED) {
+        printf("Não foi possível mapear o arquivo %s.\n", caminho);
+        return NULL;
+    }
+
+    const CabecalhoSnapshot *cab = (const CabecalhoSnapshot *)mapa;
+    uint64_t cap = cab->capacidade;
+
+    // Valida o cabeçalho e os limites antes de confiar nos campos
+    // (o vetor vem depois do cabeçalho e cabe no arquivo: por subtração, já que a soma pode dar a volta em 64 bits)
+    uint64_t tamanho = (uint64_t)st.st_size;
+    int valido = memcmp(cab->magica, "CCHASHTB", 8) == 0 &&
+                 cab->versao == versaoSnapshot &&
+                 cab->funcao == funcaoHash &&
+                 cap >= 2 && cap <= capMaxima && (cap & (cap - 1)) == 0 &&
+                 cab->qtdMat < cap &&
+                 cab->offsetMatriculas % alinhamento == 0 &&
+                 cab->offsetMatriculas >= sizeof(CabecalhoSnapshot) &&
+                 cab->offsetMatriculas <= tamanho &&
+                 cap <= (tamanho - cab->offsetMatriculas) / sizeof(long int);
+
+    long int *matriculas = valido ? (long int *)((char *)mapa + cab->offsetMatriculas) : NULL;
+    if (valido && verifica) {
+        valido = checksum(cab, matriculas, (int)cap) == cab->checksum;
+    }
+
+    if (!valido) {
+        printf("Snapshot %s inválido, corrompido ou de outra versão/política de hash.\n", caminho);
+        munmap(mapa, (size_t)st.st_size);
+        return NULL;
+    }
+
+    // Aloca memória para a tabela
+    HashTable *tabela = (HashTable *)malloc(sizeof(HashTable));
+
+    // Verifica a alocação de memória
+    if (tabela == NULL) {
+        printf("Não foi possível alocar memória para a tabela.\n");
+        munmap(mapa, (size_t)st.st_size);
+        return NULL;
+    }
+
+    tabela->matriculas = matriculas;
+    tabela->capacidade = (int)cap;
+    tabela->qtdMat = (int)cab->qtdMat;
+    tabela->config = normalizaConfig(cab->config); // Sem verifica, a configuração não passou pelo checksum
+    tabela->mapeada = 1;
+    tabela->mapa = mapa;
+    tabela->tamMapa = (size_t)st.st_size;
+    tabela->est.periodoAmostra = 1;
+    zeraEstatisticas(tabela);
+    tabela->filtro = NULL;
+
+    return tabela;
+}
+
+// Libera a memória da tabela (ou desfaz o mapeamento do snapshot)
+void liberaHash (HashTable *tabela) {
+    desativaFiltro(tabela);
+    if (tabela->mapeada) {
+        munmap(tabela->mapa, tabela->tamMapa);
+    }
+    else {
+        free(tabela->matriculas);
+    }
+    free(tabela);
+}
+
+// Define o período de amostragem (arredondado para potência de 2; 0 desativa o registro das sondagens)
+void amostragem (HashTable *tabela, unsigned int periodo) {
+    tabela->est.periodoAmostra = periodo == 0 ? 0 : (unsigned int)potenciaDe2((int)periodo);
+    tabela->est.contador = 0;
+}
+
+// Zera os contadores (mantém o período de amostragem)
+void zeraEstatisticas (HashTable *tabela) {
+    unsigned int periodo = tabela->est.periodoAmostra;
+    memset(&tabela->est, 0, sizeof(Estatisticas));
+    tabela->est.periodoAmostra = periodo;
+}
+
+// Percorre o vetor e preenche o histograma dos tamanhos dos agrupamentos primários
+void coletaAgrupamentos (HashTable *tabela) {
+    memset(tabela->est.agrupamentos, 0, sizeof(tabela->est.agrupamentos));
+    tabela->est.maiorAgrupamento = 0;
+
+    // Começa logo depois de uma posição vazia, para não partir em dois um agrupamento que dá a volta no vetor
+    int inicio = 0;
+    while (inicio < tabela->capacidade && tabela->matriculas[inicio] != -1) {
+        inicio++;
+    }
+    if (inicio == tabela->capacidade) {
+        // Nenhuma posição vazia: um único agrupamento com o vetor inteiro
+        tabela->est.agrupamentos[faixa(tabela->capacidade)]++;
+        tabela->est.maiorAgrupamento = tabela->capacidade;
+        return;
+    }
+
+    int atual = 0;
+    for (int j = 1; j <= tabela->capacidade; j++) {
+        int i = ProbingLinear(tabela->capacidade, inicio, j);
+        if (tabela->matriculas[i] != -1) {
+            atual++;
+        }
+        else if (atual > 0) {
+            tabela->est.agrupamentos[faixa(atual)]++;
+            if (atual > tabela->est.maiorAgrupamento) {
+                tabela->est.maiorAgrupamento = atual;
+            }
+            atual = 0;
+        }
+    }
+}
+
+// Escreve um histograma como vetor JSON
+void histogramaJSON (FILE *saida, const char *nome, const long int histograma[], const char *separador) {
+    fprintf(saida, "    \"%s\": [", nome);
+    for (int k = 0; k < faixasHist; k++) {
+        fprintf(saida, k == 0 ? "%ld" : ", %ld", histograma[k]);
+    }
+    fprintf(saida, "]%s\n", separador);
+}
+
+// Exporta as estatísticas da tabela em JSON (chamar coletaAgrupamentos antes para atualizar os agrupamentos)
+void exportaJSON (HashTable *tabela, FILE *saida) {
+    Estatisticas *est = &tabela->est;
+    fprintf(saida, "{\n");
+    fprintf(saida, "  \"qtdMat\": %d,\n", tabela->qtdMat);
+    fprintf(saida, "  \"capacidade\": %d,\n", tabela->capacidade);
+    fprintf(saida, "  \"txOcup\": %.4f,\n", (double)tabela->qtdMat / tabela->capacidade);
+    fprintf(saida, "  \"periodoAmostra\": %u,\n", est->periodoAmostra);
+    fprintf(saida, "  \"faixas\": \"faixa k conta valores de 2^k a 2^(k+1) - 1\",\n");
+    fprintf(saida, "  \"sondagens\": {\n");
+    histogramaJSON(saida, "insere", est->sondagensInsere, ",");
+    histogramaJSON(saida, "busca", est->sondagensBusca, ",");
+    histogramaJSON(saida, "removeMat", est->sondagensRemove, "");
+    fprintf(saida, "  },\n");
+    fprintf(saida, "  \"agrupamentos\": {\n");
+    histogramaJSON(saida, "tamanhos", est->agrupamentos, ",");
+    fprintf(saida, "    \"maior\": %d\n", est->maiorAgrupamento);
+    fprintf(saida, "  },\n");
+    fprintf(saida, "  \"redimensionamentos\": %ld,\n", est->redimensionamentos);
+    fprintf(saida, "  \"tempoRedimensionamentosMs\": %.3f,\n", est->tempoRedimensionamentos * 1e3);
+    fprintf(saida, "  \"maiorRedimensionamentoMs\": %.3f,\n", est->maiorRedimensionamento * 1e3);
+    fprintf(saida, "  \"reinsercoesReorganiza\": %ld,\n", est->reinsercoes);
+    fprintf(saida, "  \"rejeitadasFiltro\": %ld\n", est->rejeitadasFiltro);
+    fprintf(saida, "}\n");
+}
+
+// Hash do filtro, independente do hash da tabela (duas rodadas de mistura com outras constantes)
+uint64_t hashFiltro (long int matricula) {
+    uint64_t h = mistura((uint64_t)matricula ^ 0x589965CC75374CC3ull, 0x1D8E4E27C47D124Full);
+    return mistura(h ^ 0xE7037ED1A0B428DBull, 0xA0761D6478BD642Full);
+}
+
+// Bloco da matrícula: 32 bits altos do hash levados para [0, nBlocos) com multiplicação e deslocamento (nBlocos não precisa ser potência de 2)
+static inline uint64_t *blocoFiltro (FiltroBloom *filtro, uint64_t h) {
+    return filtro->blocos + (size_t)(((h >> 32) * (uint64_t)filtro->nBlocos) >> 32) * 8;
+}
+
+// As k posições dentro do bloco: 7 bits de cada vez, dos 32 bits baixos do hash e depois de novas misturas
+// (posições em progressão aritmética, a + j * b, se sobrepõem entre matrículas e a taxa real fica várias vezes acima da estimada)
+static inline void posicoesFiltro (uint64_t h, int k, unsigned int pos[]) {
+    uint64_t bits = (uint32_t)h;
+    int restantes = 32;
+    for (int j = 0; j < k; j++) {
+        if (restantes < 7) {
+            bits = mistura(h ^ (uint64_t)j, 0x8EBC6AF09C88C6E3ull);
+            restantes = 64;
+        }
+        pos[j] = bits & (contadoresBloco - 1);
+        bits >>= 7;
+        restantes -= 7;
+    }
+}
+
+// Soma "delta" (+1 ou -1) aos k contadores da matrícula. Contadores saturados (15) não mudam: só geram falsos positivos, nunca falsos negativos
+void atualizaFiltro (FiltroBloom *filtro, long int matricula, int delta) {
+    uint64_t h = hashFiltro(matricula);
+    uint64_t *bloco = blocoFiltro(filtro, h);
+    unsigned int pos[16];
+    posicoesFiltro(h, filtro->k, pos);
+
+    // Uma posição repetida é contada duas vezes, na adição e na retirada
+    for (int j = 0; j < filtro->k; j++) {
+        int desloc = (pos[j] & 15) * 4;
+        uint64_t contador = (bloco[pos[j] >> 4] >> desloc) & 15;
+        if (contador == contadorMax || (delta < 0 && contador == 0)) {
+            continue;
+        }
+        bloco[pos[j] >> 4] += (delta > 0 ? 1ull : -1ull) << desloc;
+    }
+}
+
+// Registra uma matrícula inserida na tabela
+void adicionaFiltro (FiltroBloom *filtro, long int matricula) {
+    atualizaFiltro(filtro, matricula, 1);
+}
+
+// Retira uma matrícula removida da tabela
+void retiraFiltro (FiltroBloom *filtro, long int matricula) {
+    atualizaFiltro(filtro, matricula, -1);
+}
+
+// 0: a matrícula com certeza não está na tabela; 1: pode estar
+int talvezContem (FiltroBloom *filtro, long int matricula) {
+    uint64_t h = hashFiltro(matricula);
+    uint64_t *bloco = blocoFiltro(filtro, h);
+    unsigned int pos[16];
+    posicoesFiltro(h, filtro->k, pos);
+
+    for (int j = 0; j < filtro->k; j++) {
+        if (((bloco[pos[j] >> 4] >> ((pos[j] & 15) * 4)) & 15) == 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// k e taxa de falsos positivos estimada para 1 a 32 contadores por matrícula (linha c - 1), em blocos de 128 contadores.
+// Em blocos a taxa é maior que a da fórmula do filtro de Bloom, porque alguns blocos recebem mais matrículas que a média:
+// as estimativas somam sobre a distribuição de Poisson das matrículas por bloco, com o k que minimiza a taxa
+static const struct {
+    int k;
+    double fp;
+} tabelaFiltro[32] = {
+    {1, 0.632}, // c = 1
+    {1, 0.393}, // c = 2
+    {2, 0.238}, // c = 3
+    {3, 0.151}, // c = 4
+    {3, 0.0959}, // c = 5
+    {4, 0.0619}, // c = 6
+    {4, 0.041}, // c = 7
+    {5, 0.0274}, // c = 8
+    {5, 0.0187}, // c = 9
+    {6, 0.013}, // c = 10
+    {6, 0.00917}, // c = 11
+    {6, 0.00663}, // c = 12
+    {7, 0.00481}, // c = 13
+    {7, 0.00355}, // c = 14
+    {7, 0.00267}, // c = 15
+    {8, 0.00203}, // c = 16
+    {8, 0.00155}, // c = 17
+    {8, 0.0012}, // c = 18
+    {8, 0.000939}, // c = 19
+    {8, 0.000746}, // c = 20
+    {9, 0.000592}, // c = 21
+    {9, 0.000475}, // c = 22
+    {9, 0.000384}, // c = 23
+    {9, 0.000314}, // c = 24
+    {9, 0.000258}, // c = 25
+    {10, 0.000214}, // c = 26
+    {10, 0.000177}, // c = 27
+    {10, 0.000148}, // c = 28
+    {10, 0.000124}, // c = 29
+    {10, 0.000105}, // c = 30
+    {10, 8.93e-05}, // c = 31
+    {10, 7.63e-05}, // c = 32
+};
+
+// Redimensiona o filtro para a ocupação máxima da capacidade atual e registra todas as matrículas. Retorna 0 em caso de falha
+// Com o orçamento limitando a memória, k vem da linha da tabelaFiltro que coube e a taxa real fica acima da pedida
+int reconstroiFiltro (HashTable *tabela) {
+    FiltroBloom *filtro = tabela->filtro;
+
+    // Menor quantidade de contadores por matrícula cuja taxa estimada não passa da pedida
+    int porMatricula = 1;
+    while (porMatricula < 32 && tabelaFiltro[porMatricula - 1].fp > filtro->fpAlvo) {
+        porMatricula++;
+    }
+
+    // Blocos para as matrículas previstas, sem arredondar para potência de 2 (a memória acompanha a taxa pedida)
+    double previstas = tabela->capacidade * tabela->config.ocupMax;
+    double blocosExatos = previstas * porMatricula / contadoresBloco;
+    int nBlocos = blocosExatos >= (1 << 26) ? (1 << 26) : (int)blocosExatos + 1;
+
+    // Limita ao orçamento
+    if (filtro->orcamento != 0 && (size_t)nBlocos * 64 > filtro->orcamento) {
+        nBlocos = filtro->orcamento < 64 ? 1 : (int)(filtro->orcamento / 64);
+    }
+
+    // k pela quantidade de contadores por matrícula que realmente coube
+    double disponiveis = (double)nBlocos * contadoresBloco / previstas;
+    int linha = disponiveis >= 32 ? 32 : (disponiveis < 1 ? 1 : (int)disponiveis);
+    int k = tabelaFiltro[linha - 1].k;
+
+    // Aloca os blocos alinhados à linha de cache
+    uint64_t *blocos = (uint64_t *)aligned_alloc(64, (size_t)nBlocos * 64);
+
+    // Verifica a alocação de memória
+    if (blocos == NULL) {
+        printf("Não foi possível alocar memória para o filtro.\n");
+        return 0;
+    }
+    memset(blocos, 0, (size_t)nBlocos * 64);
+
+    free(filtro->blocos);
+    filtro->blocos = blocos;
+    filtro->nBlocos = nBlocos;
+    filtro->k = k;
+
+    for (int i = 0; i < tabela->capacidade; i++) {
+        if (tabela->matriculas[i] != -1) {
+            adicionaFiltro(filtro, tabela->matriculas[i]);
         }
     }
+
+    return 1;
+}
+
+// Ativa o filtro com a taxa de falsos positivos fpAlvo (entre 0 e 1) e até "orcamento" bytes (0 = sem limite). Retorna 0 em caso de falha
+int ativaFiltro (HashTable *tabela, double fpAlvo, size_t orcamento) {
+    if (fpAlvo <= 0 || fpAlvo >= 1) {
+        printf("Taxa de falsos positivos inválida: %f.\n", fpAlvo);
+        return 0;
+    }
+
+    desativaFiltro(tabela);
+
+    // Aloca memória para o filtro
+    FiltroBloom *filtro = (FiltroBloom *)malloc(sizeof(FiltroBloom));
+
+    // Verifica a alocação de memória
+    if (filtro == NULL) {
+        printf("Não foi possível alocar memória para o filtro.\n");
+        return 0;
+    }
+
+    filtro->blocos = NULL;
+    filtro->fpAlvo = fpAlvo;
+    filtro->orcamento = orcamento;
+    tabela->filtro = filtro;
+
+    if (!reconstroiFiltro(tabela)) {
+        desativaFiltro(tabela);
+        return 0;
+    }
+
+    return 1;
+}
+
+// Desativa o filtro e libera a memória dele
+void desativaFiltro (HashTable *tabela) {
+    if (tabela->filtro != NULL) {
+        free(tabela->filtro->blocos);
+        free(tabela->filtro);
+        tabela->filtro = NULL;
+    }
 }
 
 // Função para imprimir as matrículas
@@ -246,10 +1098,62 @@ void imprime (HashTable *tabela) {
     }
 }
 
+// Sondagem média e maior agrupamento ao inserir as matrículas chaves[0..n-1] com probing linear em 2^bits posições
+void qualidadeHash (const char *nome, unsigned int (*funcao)(long int, int), long int chaves[], int n, int bits) {
+    int capacidade = 1 << bits;
+    char *ocupado = (char *)calloc(capacidade, sizeof(char));
+
+    // Verifica a alocação de memória
+    if (ocupado == NULL) {
+        printf("Não foi possível alocar memória para o teste de qualidade.\n");
+        return;
+    }
+
+    long int sondagens = 0;
+    for (int i = 0; i < n; i++) {
+        unsigned int index = funcao(chaves[i], bits);
+        int j = 0;
+        while (ocupado[ProbingLinear(capacidade, index, j)]) {
+            j++;
+        }
+        ocupado[ProbingLinear(capacidade, index, j)] = 1;
+        sondagens += j + 1;
+    }
+
+    // Maior sequência de posições ocupadas (agrupamento), considerando a volta circular
+    int maiorAgrup = 0;
+    int atual = 0;
+    for (int i = 0; i < 2 * capacidade; i++) {
+        atual = ocupado[i & (capacidade - 1)] ? atual + 1 : 0;
+        if (atual > maiorAgrup) {
+            maiorAgrup = atual;
+        }
+    }
+    if (maiorAgrup > n) {
+        maiorAgrup = n;
+    }
+
+    // Esperado para hash aleatório com probing linear (Knuth): (1 + 1 / (1 - α)) / 2
+    double alfa = (double)n / capacidade;
+    double esperado = (1 + 1 / (1 - alfa)) / 2;
+    double media = (double)sondagens / n;
+    printf("  %-15s sondagem média = %5.2f (aleatório: %.2f) | maior agrupamento = %6d %s\n", nome, media, esperado, maiorAgrup,
+           media <= esperado * 1.10 ? "OK" : "PIOR QUE ALEATÓRIO");
+
+    free(ocupado);
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
 int main () {
 
     // Inicializa a hash table
-    HashTable *tabela = init_hash();
+    HashTable *tabela = init_hash(configPadrao());
 
     long int retorno;
 
@@ -297,9 +1201,288 @@ int main () {
         printf("Matrícula %ld não encontrada.\n", matricula);
     }    
 
+    printf("\n");
+
+    // Qualidade das políticas de hash em faixas sequenciais de matrículas (ocupação 0.80 em 2^20 posições)
+    int bits = 20;
+    int n = (int)((1 << bits) * ocupMaxPadrao);
+    long int *chaves = (long int *)malloc(sizeof(long int) * n);
+
+    // Verifica a alocação de memória
+    if (chaves == NULL) {
+        printf("Não foi possível alocar memória para as matrículas.\n");
+        return 1;
+    }
+
+    const char *faixas[] = {"Sequencial (20240000001, 20240000002, ...)", "Por turma (ano * 10^7 + turma * 1000 + aluno)", "Passo 1024"};
+    for (int f = 0; f < 3; f++) {
+        for (int i = 0; i < n; i++) {
+            if (f == 0) {
+                chaves[i] = 20240000001L + i;
+            }
+            else if (f == 1) {
+                chaves[i] = (2015L + i / 90000) * 10000000L + (i / 300 % 300) * 1000 + i % 300;
+            }
+            else {
+                chaves[i] = 20240000001L + (long int)i * 1024;
+            }
+        }
+
+        printf("%s:\n", faixas[f]);
+        qualidadeHash("Fibonacci", hashFibonacci, chaves, n, bits);
+        qualidadeHash("Multiply-shift", hashMultShift, chaves, n, bits);
+        qualidadeHash("Estilo wyhash", hashWy, chaves, n, bits);
+    }
+
+    printf("\n");
+
+    // Operações em lote contra chamadas individuais, com um lote de 10^6 matrículas
+    int tamanhoLote = 1000000;
+    long int *lote = (long int *)malloc(sizeof(long int) * tamanhoLote);
+    int *resultados = (int *)malloc(sizeof(int) * tamanhoLote);
+    HashTable *individual = init_hash(configPadrao());
+    HashTable *emLote = init_hash(configPadrao());
+
+    // Verifica a alocação de memória
+    if (lote == NULL || resultados == NULL || individual == NULL || emLote == NULL) {
+        printf("Não foi possível alocar memória para o lote.\n");
+        return 1;
+    }
+
+    srand(43);
+    for (int i = 0; i < tamanhoLote; i++) {
+        lote[i] = 10000000000L + (((long int)rand() << 20) ^ rand()) % 90000000000L;
+    }
+
+    double inicio = agora();
+    for (int i = 0; i < tamanhoLote; i++) {
+        insere(individual, lote[i]);
+    }
+    double tempoIndividual = agora() - inicio;
+
+    inicio = agora();
+    insere_lote(emLote, lote, tamanhoLote, NULL);
+    double tempoLote = agora() - inicio;
+
+    printf("Inserção de %d matrículas: insere %.1f ms | insere_lote %.1f ms | %.1fx\n", tamanhoLote, tempoIndividual * 1e3, tempoLote * 1e3, tempoIndividual / tempoLote);
+
+    // Metade das consultas cadastradas, metade não
+    for (int i = 1; i < tamanhoLote; i += 2) {
+        lote[i] += 90000000000L;
+    }
+
+    int divergencias = 0;
+    inicio = agora();
+    for (int i = 0; i < tamanhoLote; i++) {
+        resultados[i] = busca(emLote, lote[i]);
+    }
+    tempoIndividual = agora() - inicio;
+    for (int i = 0; i < tamanhoLote; i++) {
+        divergencias += (resultados[i] != NAO_EXISTE) != (i % 2 == 0);
+    }
+
+    inicio = agora();
+    busca_lote(emLote, lote, tamanhoLote, resultados);
+    tempoLote = agora() - inicio;
+    for (int i = 0; i < tamanhoLote; i++) {
+        divergencias += (resultados[i] != NAO_EXISTE) != (i % 2 == 0);
+        divergencias += (i % 2 == 0) && emLote->matriculas[resultados[i]] != lote[i];
+    }
+
+    printf("Busca de %d matrículas: busca %.1f ms | busca_lote %.1f ms | %.1fx | divergências: %d\n", tamanhoLote, tempoIndividual * 1e3, tempoLote * 1e3, tempoIndividual / tempoLote, divergencias);
+
+    printf("\n");
+
+    // reserve: nenhum redimensionamento durante as inserções
+    HashTable *reservada = init_hash(configPadrao());
+    if (reservada == NULL) {
+        return 1;
+    }
+    reserve(reservada, tamanhoLote);
+    int capacidadeReservada = reservada->capacidade;
+    inicio = agora();
+    for (int i = 0; i < tamanhoLote; i += 2) {
+        insere(reservada, lote[i]);
+    }
+    printf("reserve(%d): capacidade %d antes e %d depois das inserções, %.1f ms\n", tamanhoLote, capacidadeReservada, reservada->capacidade, (agora() - inicio) * 1e3);
+
+    // Remoção em massa: a memória acompanha a quantidade de matrículas
+    printf("Ciclos de carga e expurgo de 95%%:\n");
+    for (int ciclo = 0; ciclo < 3; ciclo++) {
+        for (int i = 0; i < tamanhoLote; i += 2) {
+            insere(reservada, lote[i]);
+        }
+        printf("  ciclo %d: %7d matrículas em %8d posições (%6.1f MB)", ciclo, reservada->qtdMat, reservada->capacidade, reservada->capacidade * sizeof(long int) / 1048576.0);
+
+        for (int i = 0; i < tamanhoLote; i += 2) {
+            if (i % 40 != 0) {
+                removeMat(reservada, lote[i]);
+            }
+        }
+        printf(" -> %6d matrículas em %7d posições (%5.1f MB)\n", reservada->qtdMat, reservada->capacidade, reservada->capacidade * sizeof(long int) / 1048576.0);
+    }
+
+    // Conferência depois dos encolhimentos
+    for (int i = 0; i < tamanhoLote; i++) {
+        divergencias += (busca(reservada, lote[i]) != NAO_EXISTE) != (i % 40 == 0);
+    }
+    printf("Divergências depois dos encolhimentos: %d\n", divergencias);
+
+    printf("\n");
+
+    // Snapshot: reinício reconstruindo com insere contra carga do arquivo mapeado
+    const char *caminho = "matriculas.snap";
+    inicio = agora();
+    if (!salvaSnapshot(emLote, caminho)) {
+        return 1;
+    }
+    printf("Snapshot de %d matrículas (%.1f MB) gravado em %.1f ms\n", emLote->qtdMat, emLote->capacidade * sizeof(long int) / 1048576.0, (agora() - inicio) * 1e3);
+
+    HashTable *reconstruida = init_hash(configPadrao());
+    if (reconstruida == NULL) {
+        return 1;
+    }
+    inicio = agora();
+    for (int i = 0; i < tamanhoLote; i += 2) {
+        insere(reconstruida, lote[i]);
+    }
+    double tempoReconstrucao = agora() - inicio;
+
+    inicio = agora();
+    HashTable *carregada = carregaSnapshot(caminho, 0);
+    double tempoCarga = agora() - inicio;
+    if (carregada == NULL) {
+        return 1;
+    }
+    inicio = agora();
+    HashTable *conferida = carregaSnapshot(caminho, 1);
+    double tempoCargaVerificada = agora() - inicio;
+    if (conferida == NULL) {
+        return 1;
+    }
+    printf("Reinício: insere um a um %.1f ms | mmap %.3f ms | mmap com checksum %.1f ms\n", tempoReconstrucao * 1e3, tempoCarga * 1e3, tempoCargaVerificada * 1e3);
+
+    // A tabela carregada responde igual à original e aceita escritas (copy-on-write)
+    divergencias = 0;
+    for (int i = 0; i < tamanhoLote; i++) {
+        divergencias += (busca(carregada, lote[i]) != NAO_EXISTE) != (i % 2 == 0);
+    }
+    insere(carregada, 99999999999L);
+    removeMat(carregada, lote[0]);
+    divergencias += busca(carregada, 99999999999L) == NAO_EXISTE;
+    divergencias += busca(carregada, lote[0]) != NAO_EXISTE;
+
+    // O arquivo não muda: a outra tabela mapeada continua com o conteúdo original
+    divergencias += busca(conferida, 99999999999L) != NAO_EXISTE;
+    divergencias += busca(conferida, lote[0]) == NAO_EXISTE;
+    printf("Divergências depois das buscas e escritas na tabela mapeada: %d\n", divergencias);
+
+    printf("\n");
+
+    // Instrumentação: carga com redimensionamentos, buscas (metade ausentes) e remoções
+    HashTable *instrumentada = init_hash(configPadrao());
+    if (instrumentada == NULL) {
+        return 1;
+    }
+    for (int i = 0; i < tamanhoLote; i += 2) {
+        insere(instrumentada, lote[i]);
+    }
+    for (int i = 0; i < tamanhoLote; i++) {
+        busca(instrumentada, lote[i]);
+    }
+    for (int i = 0; i < tamanhoLote; i += 8) {
+        removeMat(instrumentada, lote[i]);
+    }
+    coletaAgrupamentos(instrumentada);
+    printf("Estatísticas de %d inserções, %d buscas e %d remoções:\n", tamanhoLote / 2, tamanhoLote, tamanhoLote / 8);
+    exportaJSON(instrumentada, stdout);
+
+    // Custo do registro: buscas sem instrumentação, com todas as operações e com 1 a cada 64
+    unsigned int periodos[] = {0, 1, 64};
+    printf("Busca de %d matrículas:", tamanhoLote);
+    for (int p = 0; p < 3; p++) {
+        amostragem(instrumentada, periodos[p]);
+        inicio = agora();
+        for (int i = 0; i < tamanhoLote; i++) {
+            busca(instrumentada, lote[i]);
+        }
+        printf(" | amostragem %u: %.1f ms", periodos[p], (agora() - inicio) * 1e3);
+    }
+    printf("\n");
+
+    printf("\n");
+
+    // Filtro de Bloom: buscas de matrículas ausentes com e sem o filtro, na ocupação máxima
+    HashTable *filtrada = init_hash(configPadrao());
+    if (filtrada == NULL) {
+        return 1;
+    }
+    reserve(filtrada, tamanhoLote);
+    int cheia = (int)(filtrada->capacidade * filtrada->config.ocupMax);
+    for (int i = 0; i < cheia; i++) {
+        insere(filtrada, 10000000000L + (long int)i * 7919L * 1000003L % 90000000000L);
+    }
+
+    double fps[] = {0.10, 0.01, 0.001};
+    for (int f = -1; f < 3; f++) {
+        const char *nome = "sem filtro";
+        char descricao[64];
+        if (f >= 0) {
+            if (!ativaFiltro(filtrada, fps[f], 0)) {
+                return 1;
+            }
+            snprintf(descricao, sizeof(descricao), "filtro %.1f%% (%.1f MB, k = %d)", fps[f] * 100, filtrada->filtro->nBlocos * 64 / 1048576.0, filtrada->filtro->k);
+            nome = descricao;
+        }
+        // Ausentes: fora do intervalo das cadastradas
+        zeraEstatisticas(filtrada);
+        inicio = agora();
+        for (int i = 0; i < tamanhoLote; i++) {
+            busca(filtrada, 100000000000L + i);
+        }
+        double tempo = agora() - inicio;
+        printf("  %-36s ausentes %6.1f ns/busca", nome, tempo * 1e9 / tamanhoLote);
+        if (f >= 0) {
+            printf(" | falsos positivos %.3f%%", 100.0 * (tamanhoLote - filtrada->est.rejeitadasFiltro) / tamanhoLote);
+        }
+        printf("\n");
+    }
+
+    // Orçamento de memória menor que o pedido pela taxa: o filtro encolhe e a taxa real sobe
+    ativaFiltro(filtrada, 0.001, 1 << 20);
+    zeraEstatisticas(filtrada);
+    for (int i = 0; i < tamanhoLote; i++) {
+        busca(filtrada, 100000000000L + i);
+    }
+    printf("  filtro 0.1%% limitado a 1 MB (k = %d):   falsos positivos %.3f%%\n", filtrada->filtro->k, 100.0 * (tamanhoLote - filtrada->est.rejeitadasFiltro) / tamanhoLote);
+
+    // Remoções e reinserções mantêm o filtro consistente: nenhuma cadastrada é rejeitada e as removidas voltam a ser rejeitadas
+    ativaFiltro(filtrada, 0.01, 0);
+    for (int i = 0; i < cheia; i += 2) {
+        removeMat(filtrada, 10000000000L + (long int)i * 7919L * 1000003L % 90000000000L);
+    }
+    divergencias = 0;
+    zeraEstatisticas(filtrada);
+    for (int i = 0; i < cheia; i++) {
+        long int m = 10000000000L + (long int)i * 7919L * 1000003L % 90000000000L;
+        divergencias += (busca(filtrada, m) != NAO_EXISTE) != (i % 2 == 1);
+    }
+    printf("Depois de remover metade (%d matrículas, capacidade %d): %d divergências, %.1f%% das removidas rejeitadas pelo filtro\n", filtrada->qtdMat,
+           filtrada->capacidade, divergencias, 100.0 * filtrada->est.rejeitadasFiltro / ((cheia + 1) / 2));
+
     // Libera a memória
-    free(tabela->matriculas);
-    free(tabela);
+    liberaHash(filtrada);
+    liberaHash(instrumentada);
+    liberaHash(carregada);
+    liberaHash(conferida);
+    liberaHash(reconstruida);
+    liberaHash(reservada);
+    liberaHash(individual);
+    liberaHash(emLote);
+    liberaHash(tabela);
+    free(chaves);
+    free(lote);
+    free(resultados);
 
     return 0;
 }
\ No newline at end of file
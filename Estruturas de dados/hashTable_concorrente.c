@@ -0,0 +1,536 @@
+// ## Hash Table Concorrente: Busca sem Trava, Inserção por CAS e Redimensionamento Cooperativo ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+// Constantes
+#define capInicial 8 // Tamanho inicial da tabela (potência de 2)
+#define ocupMax 0.80 // Taxa de ocupação máxima (matrículas + apagadas)
+#define tamBlocoMigracao 1024 // Posições migradas por vez por cada thread que ajuda
+#define VAZIO -1L
+#define APAGADO -2L
+#define MOVIDO -3L // Posição vazia ou apagada já congelada pela migração
+#define CONGELADO (1L << 62) // Bit ligado nas matrículas já congeladas pela migração
+#define maxThreads 64
+
+/*
+Obs.: o hashTable.c usa a variável global tamTab e escreve nas posições sem nenhuma sincronização, então com várias threads ele precisa de uma trava global, e todas as buscas esperam umas pelas outras.
+
+Aqui cada posição é um _Atomic long int:
+- busca: só lê as posições (atomic_load), sem trava nenhuma;
+- insere: tenta um CAS de VAZIO para a matrícula na primeira posição vazia da sondagem. Se outra thread ocupou a posição antes, a mesma posição é relida: se for a mesma matrícula, EXISTE; senão a sondagem continua. Duas inserções da mesma matrícula percorrem a mesma sequência e disputam a mesma posição vazia, então não há duplicatas;
+- removeMat: CAS da matrícula para APAGADO (a sondagem linear não permite esvaziar a posição sem travar os vizinhos). As APAGADO contam na ocupação e somem na próxima migração.
+
+Redimensionamento cooperativo: quando a ocupação passa de ocupMax, uma thread aloca a tabela seguinte (proxima). A partir daí toda thread que tenta escrever ajuda a migrar: pega blocos de tamBlocoMigracao posições com um fetch_add e, para cada posição, congela o valor com CAS (VAZIO/APAGADO viram MOVIDO; matrículas ganham o bit CONGELADO) e copia as matrículas para a tabela seguinte. Uma posição congelada não aceita mais CAS de inserção nem de remoção, então nada se perde entre a cópia e a troca. Quando o último bloco termina, a tabela atual passa a ser a seguinte; escritores só usam a tabela nova depois disso.
+
+As buscas continuam sem trava durante a migração: a tabela antiga continua com todas as matrículas (congeladas ou não). Se a busca passou por alguma posição congelada e a tabela atual já mudou, ela é refeita na tabela nova, para não devolver uma matrícula removida depois da troca.
+
+As tabelas antigas não são liberadas na troca (uma busca pode ainda estar lendo): ficam em uma lista e são liberadas no liberaHash. Como a capacidade dobra, elas somam menos que a tabela atual.
+*/
+
+// Tipos enumerados
+typedef enum status {
+    SUCESSO = 0,
+    EXISTE = -1,
+    NAO_EXISTE = -2,
+    TABELA_CHEIA = -3
+} status;
+
+// Um vetor de posições (uma "geração" da tabela)
+typedef struct Tabela {
+    _Atomic long int *matriculas;
+    int capacidade; // Potência de 2
+    atomic_int ocupadas; // Matrículas + APAGADO
+    _Atomic(struct Tabela *) proxima; // Tabela em construção pela migração (NULL se não há)
+    atomic_int proxBloco; // Próximo bloco a migrar
+    atomic_int blocosFeitos; // Blocos já migrados
+    struct Tabela *aposentada; // Lista de tabelas antigas
+} Tabela;
+
+// Estrutura da Hash concorrente
+typedef struct HashConc {
+    _Atomic(Tabela *) atual;
+    atomic_int qtdMat; // Quantidade de matrículas cadastradas
+    pthread_mutex_t travaAposentadas;
+    Tabela *aposentadas;
+} HashConc;
+
+// Cabeçalho
+HashConc *init_hash (int capacidade);
+unsigned int hash (int capacidade, long int matricula);
+unsigned int ProbingLinear (int capacidade, unsigned int index, int i);
+int insere (HashConc *h, long int matricula);
+int busca (HashConc *h, long int matricula);
+long int removeMat (HashConc *h, long int matricula);
+void liberaHash (HashConc *h);
+
+// Aloca uma tabela com todas as posições VAZIO. Retorna NULL em caso de falha
+Tabela *novaTabela (int capacidade) {
+    Tabela *t = (Tabela *)malloc(sizeof(Tabela));
+
+    // Verifica a alocação de memória
+    if (t == NULL) {
+        printf("Não foi possível alocar memória para a tabela.\n");
+        return NULL;
+    }
+
+    t->matriculas = (_Atomic long int *)malloc(sizeof(_Atomic long int) * capacidade);
+
+    // Verifica a alocação de memória
+    if (t->matriculas == NULL) {
+        printf("Não foi possível alocar memória para as matrículas.\n");
+        free(t);
+        return NULL;
+    }
+
+    for (int i = 0; i < capacidade; i++) {
+        atomic_init(&t->matriculas[i], VAZIO);
+    }
+
+    t->capacidade = capacidade;
+    atomic_init(&t->ocupadas, 0);
+    atomic_init(&t->proxima, NULL);
+    atomic_init(&t->proxBloco, 0);
+    atomic_init(&t->blocosFeitos, 0);
+    t->aposentada = NULL;
+
+    return t;
+}
+
+// Inicializa a tabela
+HashConc *init_hash (int capacidade) {
+    int cap = capInicial;
+    while (cap < capacidade) {
+        cap *= 2;
+    }
+
+    // Aloca memória para a hash
+    HashConc *h = (HashConc *)malloc(sizeof(HashConc));
+
+    // Verifica a alocação de memória
+    if (h == NULL) {
+        printf("Não foi possível alocar memória para a tabela.\n");
+        return NULL;
+    }
+
+    Tabela *t = novaTabela(cap);
+    if (t == NULL) {
+        free(h);
+        return NULL;
+    }
+
+    atomic_init(&h->atual, t);
+    atomic_init(&h->qtdMat, 0);
+    pthread_mutex_init(&h->travaAposentadas, NULL);
+    h->aposentadas = NULL;
+
+    return h;
+}
+
+// Função hash: Fibonacci, com os bits mais altos do produto (capacidade potência de 2)
+unsigned int hash (int capacidade, long int matricula) {
+    return (unsigned int)(((uint64_t)matricula * 11400714819323198485ull) >> (64 - __builtin_ctz(capacidade)));
+}
+
+// Calcula um novo índice em caso de colisão
+unsigned int ProbingLinear (int capacidade, unsigned int index, int i) {
+    return (index + i) & (capacidade - 1);
+}
+
+// Matrícula guardada em um valor de posição (sem o bit CONGELADO)
+static inline long int matriculaDe (long int v) {
+    return (v >= 0) ? (v & ~CONGELADO) : v;
+}
+
+// Posição congelada pela migração
+static inline int congelada (long int v) {
+    return v == MOVIDO || (v >= 0 && (v & CONGELADO));
+}
+
+// Cópia de uma matrícula para a tabela seguinte (só as threads da migração escrevem nela antes da troca)
+void copia (Tabela *n, long int matricula) {
+    unsigned int index = hash(n->capacidade, matricula);
+
+    while (1) {
+        long int esperado = VAZIO;
+        if (atomic_compare_exchange_strong(&n->matriculas[index], &esperado, matricula)) {
+            atomic_fetch_add(&n->ocupadas, 1);
+            return;
+        }
+        index = ProbingLinear(n->capacidade, index, 1);
+    }
+}
+
+// Congela e copia as posições do bloco b da tabela t
+void migraBloco (Tabela *t, Tabela *n, int b) {
+    int inicio = b * tamBlocoMigracao;
+    int fim = inicio + tamBlocoMigracao;
+    if (fim > t->capacidade) {
+        fim = t->capacidade;
+    }
+
+    for (int i = inicio; i < fim; i++) {
+        long int v = atomic_load(&t->matriculas[i]);
+
+        while (1) {
+            // Vazia ou apagada: vira MOVIDO
+            if (v == VAZIO || v == APAGADO) {
+                if (atomic_compare_exchange_strong(&t->matriculas[i], &v, MOVIDO)) {
+                    break;
+                }
+            }
+            // Matrícula: congela e copia
+            else {
+                if (atomic_compare_exchange_strong(&t->matriculas[i], &v, v | CONGELADO)) {
+                    copia(n, v);
+                    break;
+                }
+            }
+            // O CAS falhou: v foi recarregado com o valor novo e a posição é reexaminada
+        }
+    }
+}
+
+// Ajuda a migração de t até ela terminar e troca a tabela atual
+void ajudaMigracao (HashConc *h, Tabela *t) {
+    Tabela *n = atomic_load(&t->proxima);
+    int totalBlocos = (t->capacidade + tamBlocoMigracao - 1) / tamBlocoMigracao;
+
+    int b;
+    while ((b = atomic_fetch_add(&t->proxBloco, 1)) < totalBlocos) {
+        migraBloco(t, n, b);
+        atomic_fetch_add(&t->blocosFeitos, 1);
+    }
+
+    // Espera os blocos pegos por outras threads
+    while (atomic_load(&t->blocosFeitos) < totalBlocos) {
+        sched_yield();
+    }
+
+    // Só uma thread consegue trocar; ela aposenta a tabela antiga
+    Tabela *esperado = t;
+    if (atomic_compare_exchange_strong(&h->atual, &esperado, n)) {
+        pthread_mutex_lock(&h->travaAposentadas);
+        t->aposentada = h->aposentadas;
+        h->aposentadas = t;
+        pthread_mutex_unlock(&h->travaAposentadas);
+    }
+}
+
+// Inicia (ou junta-se a) uma migração de t. Retorna 0 em caso de falha de alocação
+int iniciaMigracao (HashConc *h, Tabela *t) {
+    if (atomic_load(&t->proxima) == NULL) {
+        // Muitas APAGADO: mesmo tamanho. Senão, dobra
+        int capacidade = (atomic_load(&h->qtdMat) + 1 > t->capacidade * ocupMax / 2) ? t->capacidade * 2 : t->capacidade;
+        Tabela *n = novaTabela(capacidade);
+        if (n == NULL) {
+            return 0;
+        }
+
+        // Outra thread pode ter criado a seguinte antes
+        Tabela *esperado = NULL;
+        if (!atomic_compare_exchange_strong(&t->proxima, &esperado, n)) {
+            free(n->matriculas);
+            free(n);
+        }
+    }
+
+    ajudaMigracao(h, t);
+    return 1;
+}
+
+// Função para buscar uma matrícula, sem travas. Retorna a posição ou NAO_EXISTE
+int busca (HashConc *h, long int matricula) {
+    while (1) {
+        Tabela *t = atomic_load(&h->atual);
+        unsigned int index = hash(t->capacidade, matricula);
+        int viuCongelada = 0;
+        int resultado = NAO_EXISTE;
+
+        for (int i = 0; i < t->capacidade; i++) {
+            long int v = atomic_load_explicit(&t->matriculas[index], memory_order_acquire);
+
+            if (v == VAZIO) {
+                break;
+            }
+            viuCongelada |= congelada(v);
+            if (matriculaDe(v) == matricula) {
+                resultado = index;
+                break;
+            }
+            index = ProbingLinear(t->capacidade, index, 1);
+        }
+
+        // Passou por posição congelada e a migração já terminou: refaz na tabela nova
+        if (viuCongelada && atomic_load(&h->atual) != t) {
+            continue;
+        }
+
+        return resultado;
+    }
+}
+
+// Função para inserir uma matrícula na hash table
+int insere (HashConc *h, long int matricula) {
+    while (1) {
+        Tabela *t = atomic_load(&h->atual);
+
+        // Migração em andamento: ajuda e recomeça na tabela nova
+        if (atomic_load(&t->proxima) != NULL) {
+            ajudaMigracao(h, t);
+            continue;
+        }
+
+        // Verifica a taxa de ocupação
+        if (atomic_load(&t->ocupadas) + 1 > t->capacidade * ocupMax) {
+            if (!iniciaMigracao(h, t)) {
+                return TABELA_CHEIA;
+            }
+            continue;
+        }
+
+        unsigned int index = hash(t->capacidade, matricula);
+
+        for (int i = 0; i < t->capacidade; ) {
+            long int v = atomic_load(&t->matriculas[index]);
+
+            if (congelada(v)) {
+                break;
+            }
+            if (v == matricula) {
+                return EXISTE;
+            }
+            if (v == VAZIO) {
+                if (atomic_compare_exchange_strong(&t->matriculas[index], &v, matricula)) {
+                    atomic_fetch_add(&t->ocupadas, 1);
+                    atomic_fetch_add(&h->qtdMat, 1);
+                    return SUCESSO;
+                }
+                continue; // Outra thread escreveu aqui: reexamina a mesma posição
+            }
+
+            index = ProbingLinear(t->capacidade, index, 1);
+            i++;
+        }
+
+        // Sondagem interrompida por posição congelada (ou tabela cheia): ajuda a migração e recomeça
+        if (!iniciaMigracao(h, t)) {
+            return TABELA_CHEIA;
+        }
+    }
+}
+
+// Remove uma matrícula (marca APAGADO)
+long int removeMat (HashConc *h, long int matricula) {
+    while (1) {
+        Tabela *t = atomic_load(&h->atual);
+
+        // Migração em andamento: ajuda e recomeça na tabela nova
+        if (atomic_load(&t->proxima) != NULL) {
+            ajudaMigracao(h, t);
+            continue;
+        }
+
+        unsigned int index = hash(t->capacidade, matricula);
+        int congelou = 0;
+
+        for (int i = 0; i < t->capacidade; ) {
+            long int v = atomic_load(&t->matriculas[index]);
+
+            if (congelada(v)) {
+                congelou = 1;
+                break;
+            }
+            if (v == VAZIO) {
+                return NAO_EXISTE;
+            }
+            if (v == matricula) {
+                if (atomic_compare_exchange_strong(&t->matriculas[index], &v, APAGADO)) {
+                    atomic_fetch_add(&h->qtdMat, -1);
+                    return matricula;
+                }
+                continue; // Outra thread mudou a posição: reexamina
+            }
+
+            index = ProbingLinear(t->capacidade, index, 1);
+            i++;
+        }
+
+        if (!congelou) {
+            return NAO_EXISTE;
+        }
+        ajudaMigracao(h, t);
+    }
+}
+
+// Libera a tabela atual e as aposentadas (sem threads usando a hash)
+void liberaHash (HashConc *h) {
+    Tabela *t = atomic_load(&h->atual);
+    free(t->matriculas);
+    free(t);
+
+    while (h->aposentadas != NULL) {
+        Tabela *prox = h->aposentadas->aposentada;
+        free(h->aposentadas->matriculas);
+        free(h->aposentadas);
+        h->aposentadas = prox;
+    }
+
+    pthread_mutex_destroy(&h->travaAposentadas);
+    free(h);
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Argumentos das threads de teste
+typedef struct Trabalho {
+    HashConc *h;
+    pthread_mutex_t *travaGlobal; // Se não for NULL, cada operação passa pela trava global
+    long int *chaves;
+    int n;
+    int id;
+    int qtdThreads;
+    int operacoes;
+    long int achadas;
+    int divergencias; // Retornos de insere diferentes do esperado
+} Trabalho;
+
+// Insere as matrículas id, id + qtdThreads, ... (todas as threads juntas fazem a tabela crescer)
+void *insereParte (void *arg) {
+    Trabalho *w = (Trabalho *)arg;
+
+    for (int i = w->id; i < w->n; i += w->qtdThreads) {
+        // A primeira deve devolver SUCESSO e a segunda, EXISTE
+        int primeira = insere(w->h, w->chaves[i]);
+        int segunda = insere(w->h, w->chaves[i]);
+        w->divergencias += primeira != SUCESSO || segunda != EXISTE;
+    }
+    return NULL;
+}
+
+// 98% buscas, 1% inserções e 1% remoções de matrículas da metade de cima
+void *cargaLeitura (void *arg) {
+    Trabalho *w = (Trabalho *)arg;
+    unsigned int semente = 2654435761u * (w->id + 1);
+
+    for (int i = 0; i < w->operacoes; i++) {
+        semente = semente * 1103515245u + 12345u;
+        int sorteio = (semente >> 8) % 100;
+        semente = semente * 1103515245u + 12345u;
+        long int k = w->chaves[(semente >> 4) % w->n];
+
+        if (w->travaGlobal != NULL) {
+            pthread_mutex_lock(w->travaGlobal);
+        }
+
+        if (sorteio < 98) {
+            w->achadas += busca(w->h, k) != NAO_EXISTE;
+        }
+        else {
+            long int k2 = w->chaves[w->n + (semente >> 4) % w->n];
+            if (sorteio == 98) {
+                insere(w->h, k2);
+            }
+            else {
+                removeMat(w->h, k2);
+            }
+        }
+
+        if (w->travaGlobal != NULL) {
+            pthread_mutex_unlock(w->travaGlobal);
+        }
+    }
+    return NULL;
+}
+
+int main () {
+    int n = 1 << 20;
+    long int *chaves = (long int *)malloc(sizeof(long int) * 2 * n);
+    pthread_t threads[maxThreads];
+    Trabalho trabalhos[maxThreads];
+
+    // Verifica a alocação de memória
+    if (chaves == NULL) {
+        printf("Não foi possível alocar memória para as matrículas.\n");
+        return 1;
+    }
+
+    // Matrículas distintas: i * m mod 9 * 10^10 é uma bijeção (m primo com 2, 3 e 5)
+    for (int i = 0; i < 2 * n; i++) {
+        chaves[i] = 10000000000L + (long int)i * 7919L * 1000003L % 90000000000L;
+    }
+
+    int qtdCores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int maxT = (qtdCores * 2 < 8) ? 8 : qtdCores * 2;
+    if (maxT > maxThreads) {
+        maxT = maxThreads;
+    }
+
+    // Inserção concorrente a partir de 8 posições: a tabela migra várias vezes com as threads ajudando
+    printf("## Inserção concorrente (%d threads, %d matrículas, tabela inicial com %d posições) ##\n", maxT, n, capInicial);
+    HashConc *h = init_hash(capInicial);
+    if (h == NULL) {
+        return 1;
+    }
+
+    for (int t = 0; t < maxT; t++) {
+        trabalhos[t] = (Trabalho){h, NULL, chaves, n, t, maxT, 0, 0, 0};
+        if (pthread_create(&threads[t], NULL, insereParte, &trabalhos[t]) != 0) {
+            printf("Não foi possível criar a thread %d.\n", t);
+            return 1;
+        }
+    }
+    int erros = 0;
+    for (int t = 0; t < maxT; t++) {
+        pthread_join(threads[t], NULL);
+        erros += trabalhos[t].divergencias;
+    }
+
+    for (int i = 0; i < 2 * n; i++) {
+        erros += (busca(h, chaves[i]) != NAO_EXISTE) != (i < n);
+    }
+    Tabela *t = atomic_load(&h->atual);
+    printf("qtdMat = %d | Capacidade = %d | divergências = %d\n\n", atomic_load(&h->qtdMat), t->capacidade, erros);
+
+    // Carga de leitura: trava global (como o serviço faz hoje) contra a tabela concorrente
+    printf("## Carga 98%% busca / 2%% escrita (%d núcleos) ##\n", qtdCores);
+    pthread_mutex_t travaGlobal = PTHREAD_MUTEX_INITIALIZER;
+    int operacoes = 2000000;
+
+    for (int qtd = 1; qtd <= maxT; qtd *= 2) {
+        double vazao[2];
+
+        for (int modo = 0; modo < 2; modo++) {
+            double inicio = agora();
+            for (int i = 0; i < qtd; i++) {
+                trabalhos[i] = (Trabalho){h, modo == 0 ? &travaGlobal : NULL, chaves, n, i, qtd, operacoes, 0, 0};
+                if (pthread_create(&threads[i], NULL, cargaLeitura, &trabalhos[i]) != 0) {
+                    printf("Não foi possível criar a thread %d.\n", i);
+                    return 1;
+                }
+            }
+            for (int i = 0; i < qtd; i++) {
+                pthread_join(threads[i], NULL);
+            }
+            vazao[modo] = (double)qtd * operacoes / (agora() - inicio) / 1e6;
+        }
+
+        printf("%2d threads: trava global %6.1f Mops/s | concorrente %6.1f Mops/s\n", qtd, vazao[0], vazao[1]);
+    }
+
+    liberaHash(h);
+    free(chaves);
+
+    return 0;
+}
@@ -0,0 +1,451 @@
+// ## Hash Table Cuckoo com Baldes de 4 Posições, Busca em Largura e Stash ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+// Constantes
+#define tamBalde 4 // Posições por balde (4 * 8 bytes = 32 bytes: o balde nunca cruza uma linha de cache)
+#define baldesIniciais 2 // Tamanho inicial da tabela, em baldes (potência de 2)
+#define ocupMax 0.95 // Taxa de ocupação máxima da tabela
+#define tamStash 8 // Matrículas que não couberam em nenhum dos dois baldes
+#define maxFila 512 // Baldes visitados pela busca em largura de um caminho de despejo
+#define maxProfundidade 6 // Tamanho máximo do caminho de despejo
+
+/*
+Obs.: no probing linear do hashTable.c, a busca percorre o agrupamento até achar a matrícula ou uma posição vazia. O tamanho do agrupamento não tem limite útil: com ocupação alta, algumas buscas percorrem centenas de posições.
+
+No cuckoo hashing, cada matrícula tem só dois lugares possíveis: o balde b1 e o balde b2, calculados a partir de duas partes do mesmo hash de 64 bits. A busca olha as 4 posições de b1, as 4 de b2 e, se houver matrículas no stash (um vetor pequeno dentro da própria estrutura), o stash. Nenhuma outra posição é tocada: no pior caso são duas linhas de cache, qualquer que seja a ocupação.
+
+O custo vai para a inserção: se b1 e b2 estão cheios, alguma matrícula de um deles precisa ir para o seu outro balde, o que pode exigir tirar outra matrícula de lá, e assim por diante. Esse caminho de despejos é procurado com uma busca em largura (BFS) a partir de b1 e b2, até achar um balde com posição vazia, e só então as matrículas são movidas, do fim do caminho para o começo. Com baldes de 4 posições e BFS, a tabela passa de 95% de ocupação.
+
+Se nenhum caminho for encontrado dentro de maxFila baldes, a matrícula vai para o stash. Com o stash cheio, a tabela dobra. Depois de uma remoção, as matrículas do stash tentam voltar para os seus baldes.
+*/
+
+// Tipos enumerados
+typedef enum status {
+    SUCESSO = 0,
+    EXISTE = -1,
+    NAO_EXISTE = -2,
+    TABELA_CHEIA = -3
+} status;
+
+// Balde: 4 posições (-1 = vazia), alinhado a 32 bytes
+typedef struct Balde {
+    long int matriculas[tamBalde];
+} __attribute__((aligned(32))) Balde;
+
+// Estrutura da Hash Cuckoo
+typedef struct HashCuckoo {
+    Balde *baldes;
+    int qtdBaldes; // Potência de 2
+    int qtdMat; // Quantidade de matrículas cadastradas (baldes + stash)
+    int qtdStash;
+    long int stash[tamStash];
+} HashCuckoo;
+
+// Nó da busca em largura: balde, nó de onde veio e posição (no balde do pai) da matrícula que viria para este balde
+typedef struct NoBFS {
+    int balde;
+    int pai;
+    int slot;
+} NoBFS;
+
+// Cabeçalho
+HashCuckoo *init_hash (int qtdBaldes);
+uint64_t hash (long int matricula);
+int insere (HashCuckoo *tabela, long int matricula);
+int redimensiona (HashCuckoo *tabela);
+int busca (HashCuckoo *tabela, long int matricula);
+long int removeMat (HashCuckoo *tabela, long int matricula);
+void liberaHash (HashCuckoo *tabela);
+
+// Inicializa a tabela
+HashCuckoo *init_hash (int qtdBaldes) {
+    int qtd = baldesIniciais;
+    while (qtd < qtdBaldes) {
+        qtd *= 2;
+    }
+
+    // Aloca memória para a tabela
+    HashCuckoo *tabela = (HashCuckoo *)malloc(sizeof(HashCuckoo));
+
+    // Verifica a alocação de memória
+    if (tabela == NULL) {
+        printf("Não foi possível alocar memória para a tabela.\n");
+        return NULL;
+    }
+
+    // Aloca memória para os baldes (alinhados à linha de cache)
+    tabela->baldes = (Balde *)aligned_alloc(64, sizeof(Balde) * qtd);
+
+    // Verifica a alocação de memória
+    if (tabela->baldes == NULL) {
+        printf("Não foi possível alocar memória para os baldes.\n");
+        free(tabela);
+        return NULL;
+    }
+
+    // Inicializa a tabela com valores inválidos
+    for (int b = 0; b < qtd; b++) {
+        for (int s = 0; s < tamBalde; s++) {
+            tabela->baldes[b].matriculas[s] = -1;
+        }
+    }
+
+    tabela->qtdBaldes = qtd;
+    tabela->qtdMat = 0;
+    tabela->qtdStash = 0;
+
+    return tabela;
+}
+
+// Função hash: finalizador do splitmix64 (as duas metades dão os dois baldes)
+uint64_t hash (long int matricula) {
+    uint64_t h = (uint64_t)matricula;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+// Os dois baldes da matrícula (sempre diferentes)
+static inline void baldesDe (HashCuckoo *tabela, long int matricula, int *b1, int *b2) {
+    uint64_t h = hash(matricula);
+    unsigned int mascara = tabela->qtdBaldes - 1;
+    *b1 = (int)(h & mascara);
+    *b2 = (int)((h >> 32) & mascara);
+    if (*b2 == *b1) {
+        *b2 = *b1 ^ 1;
+    }
+}
+
+// O outro balde da matrícula que está no balde b
+static inline int outroBalde (HashCuckoo *tabela, long int matricula, int b) {
+    int b1, b2;
+    baldesDe(tabela, matricula, &b1, &b2);
+    return (b == b1) ? b2 : b1;
+}
+
+// Posição vazia do balde ou -1
+static inline int posicaoVazia (Balde *balde) {
+    for (int s = 0; s < tamBalde; s++) {
+        if (balde->matriculas[s] == -1) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+// Função para buscar uma matrícula. Retorna b * tamBalde + posição, tamBalde * qtdBaldes + posição no stash, ou NAO_EXISTE
+int busca (HashCuckoo *tabela, long int matricula) {
+    int b1, b2;
+    baldesDe(tabela, matricula, &b1, &b2);
+
+    // As duas linhas de cache são pedidas juntas
+    __builtin_prefetch(&tabela->baldes[b2]);
+
+    for (int s = 0; s < tamBalde; s++) {
+        if (tabela->baldes[b1].matriculas[s] == matricula) {
+            return b1 * tamBalde + s;
+        }
+    }
+    for (int s = 0; s < tamBalde; s++) {
+        if (tabela->baldes[b2].matriculas[s] == matricula) {
+            return b2 * tamBalde + s;
+        }
+    }
+
+    // Stash (quase sempre vazio)
+    for (int i = 0; i < tabela->qtdStash; i++) {
+        if (tabela->stash[i] == matricula) {
+            return tabela->qtdBaldes * tamBalde + i;
+        }
+    }
+
+    return NAO_EXISTE;
+}
+
+// Procura um caminho de despejos a partir de b1 e b2 e coloca a matrícula. Retorna 0 se não houver caminho
+int despeja (HashCuckoo *tabela, long int matricula, int b1, int b2) {
+    NoBFS fila[maxFila];
+    int profundidade[maxFila];
+    int ini = 0;
+    int fim = 0;
+
+    fila[fim] = (NoBFS){b1, -1, -1};
+    profundidade[fim++] = 0;
+    fila[fim] = (NoBFS){b2, -1, -1};
+    profundidade[fim++] = 0;
+
+    while (ini < fim) {
+        int atual = ini++;
+        Balde *balde = &tabela->baldes[fila[atual].balde];
+
+        for (int s = 0; s < tamBalde; s++) {
+            long int k = balde->matriculas[s];
+            int alt = outroBalde(tabela, k, fila[atual].balde);
+            int vazia = posicaoVazia(&tabela->baldes[alt]);
+
+            // Caminho encontrado: move do fim para o começo
+            if (vazia != -1) {
+                tabela->baldes[alt].matriculas[vazia] = k;
+                int livre = s;
+                int no = atual;
+                while (fila[no].pai != -1) {
+                    Balde *pai = &tabela->baldes[fila[fila[no].pai].balde];
+                    tabela->baldes[fila[no].balde].matriculas[livre] = pai->matriculas[fila[no].slot];
+                    livre = fila[no].slot;
+                    no = fila[no].pai;
+                }
+                tabela->baldes[fila[no].balde].matriculas[livre] = matricula;
+                return 1;
+            }
+
+            if (fim == maxFila || profundidade[atual] + 1 >= maxProfundidade) {
+                continue;
+            }
+
+            // Não volta para um balde que já está no caminho
+            int repetido = 0;
+            for (int no = atual; no != -1 && !repetido; no = fila[no].pai) {
+                repetido = fila[no].balde == alt;
+            }
+            if (!repetido) {
+                fila[fim] = (NoBFS){alt, atual, s};
+                profundidade[fim++] = profundidade[atual] + 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Coloca a matrícula em um dos baldes (direto ou com despejos) ou no stash. Retorna 0 se não couber
+int posiciona (HashCuckoo *tabela, long int matricula) {
+    int b1, b2;
+    baldesDe(tabela, matricula, &b1, &b2);
+
+    int s1 = posicaoVazia(&tabela->baldes[b1]);
+    if (s1 != -1) {
+        tabela->baldes[b1].matriculas[s1] = matricula;
+        return 1;
+    }
+    int s2 = posicaoVazia(&tabela->baldes[b2]);
+    if (s2 != -1) {
+        tabela->baldes[b2].matriculas[s2] = matricula;
+        return 1;
+    }
+
+    if (despeja(tabela, matricula, b1, b2)) {
+        return 1;
+    }
+
+    if (tabela->qtdStash < tamStash) {
+        tabela->stash[tabela->qtdStash++] = matricula;
+        return 1;
+    }
+
+    return 0;
+}
+
+// Função para inserir uma matrícula na hash table
+int insere (HashCuckoo *tabela, long int matricula) {
+    // Matrícula já cadastrada
+    if (busca(tabela, matricula) != NAO_EXISTE) {
+        return EXISTE;
+    }
+
+    // Verifica a taxa de ocupação
+    float txOcup = (float)(tabela->qtdMat + 1) / (tabela->qtdBaldes * tamBalde);
+    if (txOcup > ocupMax && !redimensiona(tabela)) {
+        return TABELA_CHEIA;
+    }
+
+    // Sem caminho e com o stash cheio: dobra e tenta de novo
+    while (!posiciona(tabela, matricula)) {
+        if (!redimensiona(tabela)) {
+            return TABELA_CHEIA;
+        }
+    }
+
+    tabela->qtdMat++;
+    return SUCESSO;
+}
+
+// Dobra a quantidade de baldes e redistribui as matrículas (baldes e stash). Retorna 0 em caso de falha
+int redimensiona (HashCuckoo *tabela) {
+    int qtdBaldes = tabela->qtdBaldes * 2;
+
+    while (1) {
+        HashCuckoo *nova = init_hash(qtdBaldes);
+        if (nova == NULL) {
+            return 0;
+        }
+
+        // Re-hash de todas as matrículas
+        int ok = 1;
+        for (int b = 0; b < tabela->qtdBaldes && ok; b++) {
+            for (int s = 0; s < tamBalde && ok; s++) {
+                if (tabela->baldes[b].matriculas[s] != -1) {
+                    ok = posiciona(nova, tabela->baldes[b].matriculas[s]);
+                }
+            }
+        }
+        for (int i = 0; i < tabela->qtdStash && ok; i++) {
+            ok = posiciona(nova, tabela->stash[i]);
+        }
+
+        // Muito improvável: não coube nem com o dobro. Tenta com o quádruplo
+        if (!ok) {
+            liberaHash(nova);
+            qtdBaldes *= 2;
+            continue;
+        }
+
+        // A tabela passa a usar os baldes novos
+        free(tabela->baldes);
+        nova->qtdMat = tabela->qtdMat;
+        *tabela = *nova;
+        free(nova);
+
+        return 1;
+    }
+}
+
+// Função para remover uma matrícula
+long int removeMat (HashCuckoo *tabela, long int matricula) {
+    int pos = busca(tabela, matricula);
+
+    // Matrícula não encontrada
+    if (pos == NAO_EXISTE) {
+        return NAO_EXISTE;
+    }
+
+    if (pos < tabela->qtdBaldes * tamBalde) {
+        tabela->baldes[pos / tamBalde].matriculas[pos % tamBalde] = -1;
+
+        // Abriu espaço: as matrículas do stash tentam voltar para os seus baldes
+        int qtdStash = tabela->qtdStash;
+        long int stash[tamStash];
+        for (int i = 0; i < qtdStash; i++) {
+            stash[i] = tabela->stash[i];
+        }
+        tabela->qtdStash = 0;
+        for (int i = 0; i < qtdStash; i++) {
+            posiciona(tabela, stash[i]); // Cabe no máximo de volta no stash
+        }
+    }
+    else {
+        // Tira do stash trocando pela última
+        tabela->stash[pos - tabela->qtdBaldes * tamBalde] = tabela->stash[--tabela->qtdStash];
+    }
+
+    tabela->qtdMat--;
+    return matricula;
+}
+
+// Libera a memória da tabela
+void liberaHash (HashCuckoo *tabela) {
+    free(tabela->baldes);
+    free(tabela);
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+int main () {
+    // Demonstração com poucas matrículas
+    HashCuckoo *tabela = init_hash(baldesIniciais);
+    if (tabela == NULL) {
+        return 1;
+    }
+
+    printf("Inserção: \n");
+    long int matriculas[] = {12345678901, 12345678901, 12335678901, 23456789012, 34567890123, 45678901234, 12345678905, 12345678906};
+    int qtd = sizeof(matriculas) / sizeof(matriculas[0]);
+
+    for (int i = 0; i < qtd; i++) {
+        if (insere(tabela, matriculas[i]) == EXISTE) {
+            printf("Matrícula %ld já cadastrada.\n", matriculas[i]);
+        }
+    }
+    printf("qtdMat = %d | Baldes = %d | Stash = %d\n", tabela->qtdMat, tabela->qtdBaldes, tabela->qtdStash);
+    printf("Remoção de 23456789012: %s\n", removeMat(tabela, 23456789012) != NAO_EXISTE ? "removida" : "não encontrada");
+    printf("Busca de 23456789012: %s\n\n", busca(tabela, 23456789012) != NAO_EXISTE ? "encontrada" : "não encontrada");
+    liberaHash(tabela);
+
+    // Ocupação alta: 2^18 baldes (2^20 posições) cheios até ocupMax, sem deixar a tabela crescer
+    int qtdBaldes = 1 << 18;
+    int capacidade = qtdBaldes * tamBalde;
+    int total = (int)(capacidade * ocupMax) - 1;
+    tabela = init_hash(qtdBaldes);
+    long int *chaves = (long int *)malloc(sizeof(long int) * total);
+    long int *linear = (long int *)malloc(sizeof(long int) * capacidade);
+
+    // Verifica a alocação de memória
+    if (tabela == NULL || chaves == NULL || linear == NULL) {
+        printf("Não foi possível alocar memória.\n");
+        return 1;
+    }
+
+    for (int i = 0; i < capacidade; i++) {
+        linear[i] = -1;
+    }
+
+    // Mesmas matrículas em um probing linear com hash de Fibonacci (como o hashTable.c), para comparar o pior caso
+    int maxSondagem = 0;
+    long int somaSondagem = 0;
+    for (int i = 0; i < total; i++) {
+        chaves[i] = 10000000000L + (long int)i * 7919L * 1000003L % 90000000000L;
+        insere(tabela, chaves[i]);
+
+        unsigned int index = (unsigned int)(((uint64_t)chaves[i] * 11400714819323198485ull) >> (64 - 20));
+        int sondagem = 1;
+        while (linear[index] != -1) {
+            index = (index + 1) & (capacidade - 1);
+            sondagem++;
+        }
+        linear[index] = chaves[i];
+        somaSondagem += sondagem;
+        if (sondagem > maxSondagem) {
+            maxSondagem = sondagem;
+        }
+    }
+
+    printf("Ocupação de %.3f com %d baldes (cresceu: %s), stash com %d matrículas\n", (float)tabela->qtdMat / (tabela->qtdBaldes * tamBalde),
+           tabela->qtdBaldes, tabela->qtdBaldes != qtdBaldes ? "sim" : "não", tabela->qtdStash);
+    printf("Probing linear, mesma ocupação: sondagem média %.1f posições, pior caso %d posições (%d linhas de cache)\n",
+           (double)somaSondagem / total, maxSondagem, (maxSondagem + 7) / 8 + 1);
+    printf("Cuckoo: pior caso 2 baldes de %d posições (2 linhas de cache) + stash\n", tamBalde);
+
+    // Tempo de busca (existentes e ausentes)
+    int consultas = 5000000;
+    long int achadas = 0;
+    double inicio = agora();
+    for (int i = 0; i < consultas; i++) {
+        long int k = chaves[(unsigned int)(i * 2654435761u) % total];
+        achadas += busca(tabela, (i & 1) ? k : k + 90000000000L) != NAO_EXISTE;
+    }
+    printf("Busca: %.1f ns por consulta (%ld achadas de %d)\n", (agora() - inicio) * 1e9 / consultas, achadas, consultas);
+
+    // Remove metade e confere
+    for (int i = 0; i < total; i += 2) {
+        removeMat(tabela, chaves[i]);
+    }
+    int erros = 0;
+    for (int i = 0; i < total; i++) {
+        erros += (busca(tabela, chaves[i]) != NAO_EXISTE) != (i % 2 == 1);
+    }
+    printf("Após remover metade: %d divergências, qtdMat = %d\n", erros, tabela->qtdMat);
+
+    liberaHash(tabela);
+    free(chaves);
+    free(linear);
+
+    return 0;
+}
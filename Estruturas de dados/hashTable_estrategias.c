@@ -0,0 +1,678 @@
+// ## Hash Table com Estratégia de Sondagem Escolhida na Compilação e Bancada de Medição ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+// Constantes
+#define capMinima 8 // Capacidade mínima (potência de 2, múltiplo de tamBalde)
+#define ocupMaxPadrao 0.80 // Taxa de ocupação máxima padrão
+#define tamBalde 8 // Posições por balde na estratégia BALDES (8 long int = uma linha de cache)
+#define distMax 255 // Maior distância que cabe em um unsigned char (ROBIN_HOOD)
+#define VAZIO -1
+#define APAGADO -2 // Lápide: matrícula removida (QUADRATICA, HASH_DUPLO e BALDES)
+#define periodoLatencia 64 // Uma a cada periodoLatencia operações da bancada tem a latência medida
+
+// Estratégias de sondagem (escolha na compilação com -Destrategia=...)
+#define SONDAGEM_LINEAR 1
+#define SONDAGEM_QUADRATICA 2
+#define HASH_DUPLO 3
+#define ROBIN_HOOD 4
+#define BALDES 5
+#ifndef estrategia
+#define estrategia SONDAGEM_LINEAR
+#endif
+
+#if estrategia == SONDAGEM_QUADRATICA
+#define nomeEstrategia "quadrática"
+#elif estrategia == HASH_DUPLO
+#define nomeEstrategia "hash duplo"
+#elif estrategia == ROBIN_HOOD
+#define nomeEstrategia "Robin Hood"
+#elif estrategia == BALDES
+#define nomeEstrategia "baldes"
+#else
+#define nomeEstrategia "linear"
+#endif
+
+/*
+Obs.: no hashTable.c o ProbingLinear está fixo no insere e no busca. Aqui a sequência de sondagem é escolhida na compilação, como a política de hash do hashTable.c:
+  gcc -O2 -Destrategia=SONDAGEM_QUADRATICA hashTable_estrategias.c
+- SONDAGEM_LINEAR: index, index + 1, index + 2, ... Remoção sem lápides: os elementos seguintes do agrupamento que deixariam de ser alcançáveis são movidos para o buraco (algoritmo R de Knuth);
+- SONDAGEM_QUADRATICA: index + i(i+1)/2 (números triangulares, que com capacidade potência de 2 passam por todas as posições). Quebra os agrupamentos primários;
+- HASH_DUPLO: index + i * passo, com o passo ímpar tirado de outros bits do hash, então duas matrículas com o mesmo index seguem sequências diferentes;
+- ROBIN_HOOD: sondagem linear com a distância de cada elemento até a posição ideal (como o hashTable_robinHood.c): a inserção troca com ocupantes que andaram menos, a busca para quando o ocupante está mais perto de casa do que a matrícula estaria e a remoção puxa os seguintes para trás;
+- BALDES: a tabela é dividida em baldes de tamBalde posições (uma linha de cache); as posições do balde ideal são percorridas em ordem e, se ele estiver cheio, os próximos baldes seguem a sequência quadrática.
+Na quadrática, no hash duplo e nos baldes a sequência de um elemento atravessa as de outros, então a remoção não pode deixar um -1 no meio: a posição vira APAGADO (lápide), que a busca pula e a inserção reaproveita. Quando matrículas + lápides passam da metade do caminho entre ocupMax e a tabela cheia, a tabela é reconstruída com a mesma capacidade, o que limpa as lápides.
+
+Bancada: para cada ocupação de 0.50 a 0.95, a tabela tem capacidade fixa (ocupMax logo acima da ocupação medida, para não crescer) e roda as cargas:
+- inserção: enche a tabela vazia até a ocupação;
+- busca achada e busca ausente: matrículas cadastradas e nunca cadastradas, com posições espalhadas pela tabela;
+- rotatividade: remove uma matrícula antiga e insere uma nova, alternadamente (a ocupação fica constante e as lápides se acumulam);
+- mista: 80% buscas (metade achadas), 10% remoções e 10% inserções.
+Cada carga informa a vazão (milhões de operações por segundo) e o p99 da latência, medida em uma a cada periodoLatencia operações (descontado o custo das duas leituras do relógio). Compilando cada estratégia e comparando as tabelas, a estratégia pode ser escolhida pela vazão e pela latência na ocupação usada em cada implantação.
+*/
+
+// Tipos enumerados
+typedef enum status {
+    SUCESSO = 0,
+    EXISTE = -1,
+    NAO_EXISTE = -2,
+    TABELA_CHEIA = -3
+} status;
+
+// Cargas da bancada
+typedef enum carga {
+    INSERCAO,
+    BUSCA_ACHADA,
+    BUSCA_AUSENTE,
+    ROTATIVIDADE,
+    MISTA,
+    qtdCargas
+} carga;
+
+// Estrutura da Hash
+typedef struct HashTable {
+    long int *matriculas; // VAZIO, APAGADO ou a matrícula
+    unsigned char *distancias; // Distância até a posição ideal (só ROBIN_HOOD)
+    int qtdMat; // Quantidade de matrículas cadastradas
+    int qtdApagados; // Quantidade de lápides
+    int capacidade; // Potência de 2
+    float ocupMax; // Acima desta ocupação a tabela dobra
+} HashTable;
+
+// Estado da bancada: quais matrículas estão na tabela
+typedef struct Bancada {
+    long int *vivas; // Identificadores das matrículas cadastradas
+    int qtdVivas;
+    long int proxima; // Próximo identificador ainda não usado
+    int cursor; // Próxima viva a ser removida (rotatividade e mista)
+} Bancada;
+
+// Resultado de uma carga
+typedef struct Medida {
+    double mops; // Milhões de operações por segundo
+    float p99; // Nanossegundos
+} Medida;
+
+// Cabeçalho
+HashTable *init_hash (int capacidade, float ocupMax);
+unsigned int hash (int capacidade, long int matricula);
+unsigned int sonda (int capacidade, unsigned int index, unsigned int passo, int i);
+int insere (HashTable *tabela, long int matricula);
+int redimensiona (HashTable *tabela, int capacidade);
+int busca (HashTable *tabela, long int matricula);
+long int removeMat (HashTable *tabela, long int matricula);
+void liberaHash (HashTable *tabela);
+
+// Inicializa a tabela com "capacidade" posições (arredondada para potência de 2)
+HashTable *init_hash (int capacidade, float ocupMax) {
+    int cap = capMinima;
+    while (cap < capacidade) {
+        cap *= 2;
+    }
+
+    // Aloca memória para a tabela
+    HashTable *tabela = (HashTable *)malloc(sizeof(HashTable));
+
+    // Verifica a alocação de memória
+    if (tabela == NULL) {
+        printf("Não foi possível alocar memória para a tabela.\n");
+        return NULL;
+    }
+
+    tabela->matriculas = (long int *)malloc(sizeof(long int) * cap);
+    tabela->distancias = (estrategia == ROBIN_HOOD) ? (unsigned char *)calloc(cap, sizeof(unsigned char)) : NULL;
+
+    // Verifica a alocação de memória
+    if (tabela->matriculas == NULL || (estrategia == ROBIN_HOOD && tabela->distancias == NULL)) {
+        printf("Não foi possível alocar memória para as matrículas.\n");
+        free(tabela->matriculas);
+        free(tabela->distancias);
+        free(tabela);
+        return NULL;
+    }
+
+    // Inicializa a tabela com valores inválidos
+    for (int i = 0; i < cap; i++) {
+        tabela->matriculas[i] = VAZIO;
+    }
+
+    tabela->capacidade = cap;
+    tabela->qtdMat = 0;
+    tabela->qtdApagados = 0;
+    tabela->ocupMax = (ocupMax > 0 && ocupMax < 1) ? ocupMax : ocupMaxPadrao;
+
+    return tabela;
+}
+
+// Hash de Fibonacci: os bits mais altos de matricula * 2^64/φ
+unsigned int hash (int capacidade, long int matricula) {
+    return (unsigned int)(((uint64_t)matricula * 11400714819323198485ull) >> (64 - __builtin_ctz(capacidade)));
+}
+
+// Passo do hash duplo: ímpar (percorre todas as posições) e tirado dos bits baixos do mesmo produto
+unsigned int passoDuplo (long int matricula) {
+    return (unsigned int)(((uint64_t)matricula * 11400714819323198485ull) >> 1) | 1;
+}
+
+// Posição inicial da sondagem: nos baldes, o início do balde ideal
+static inline unsigned int inicio (int capacidade, long int matricula) {
+#if estrategia == BALDES
+    return hash(capacidade, matricula) & ~(unsigned int)(tamBalde - 1);
+#else
+    return hash(capacidade, matricula);
+#endif
+}
+
+// i-ésima posição da sequência de sondagem a partir de index
+unsigned int sonda (int capacidade, unsigned int index, unsigned int passo, int i) {
+#if estrategia == SONDAGEM_QUADRATICA
+    (void)passo;
+    return (unsigned int)(index + (uint64_t)i * (i + 1) / 2) & (capacidade - 1);
+#elif estrategia == HASH_DUPLO
+    return (index + (unsigned int)i * passo) & (capacidade - 1);
+#elif estrategia == BALDES
+    // Posição i % tamBalde do t-ésimo balde da sequência quadrática de baldes
+    (void)passo;
+    uint64_t t = (unsigned int)i / tamBalde;
+    return (unsigned int)(index + tamBalde * (t * (t + 1) / 2) + i % tamBalde) & (capacidade - 1);
+#else
+    (void)passo;
+    return (index + i) & (capacidade - 1);
+#endif
+}
+
+#if estrategia == ROBIN_HOOD
+
+// Coloca uma matrícula sem verificar ocupação nem duplicidade.
+// Retorna -1 se tudo foi posicionado, ou a matrícula que ficou "na mão" se alguma distância estourou distMax
+long int posiciona (HashTable *tabela, long int matricula) {
+    unsigned int index = hash(tabela->capacidade, matricula);
+    int dist = 0;
+
+    while (dist <= distMax) {
+        // Posição vazia: a matrícula (ou o elemento deslocado) fica aqui
+        if (tabela->matriculas[index] == VAZIO) {
+            tabela->matriculas[index] = matricula;
+            tabela->distancias[index] = (unsigned char)dist;
+            tabela->qtdMat++;
+            return -1;
+        }
+
+        // O ocupante andou menos: troca e continua inserindo o ocupante
+        if (tabela->distancias[index] < dist) {
+            long int tempMat = tabela->matriculas[index];
+            int tempDist = tabela->distancias[index];
+            tabela->matriculas[index] = matricula;
+            tabela->distancias[index] = (unsigned char)dist;
+            matricula = tempMat;
+            dist = tempDist;
+        }
+
+        index = sonda(tabela->capacidade, index, 0, 1);
+        dist++;
+    }
+
+    return matricula;
+}
+
+// Função para inserir uma matrícula na hash table
+int insere (HashTable *tabela, long int matricula) {
+    // Matrícula já cadastrada
+    if (busca(tabela, matricula) != NAO_EXISTE) {
+        return EXISTE;
+    }
+
+    // Verifica a taxa de ocupação
+    if (tabela->qtdMat + 1 > tabela->capacidade * tabela->ocupMax && !redimensiona(tabela, tabela->capacidade * 2)) {
+        return TABELA_CHEIA;
+    }
+
+    // Distância estourou: dobra a tabela e posiciona o elemento que sobrou
+    while ((matricula = posiciona(tabela, matricula)) != -1) {
+        if (!redimensiona(tabela, tabela->capacidade * 2)) {
+            return TABELA_CHEIA;
+        }
+    }
+
+    return SUCESSO;
+}
+
+// Função para buscar uma matrícula na hash table
+int busca (HashTable *tabela, long int matricula) {
+    unsigned int index = hash(tabela->capacidade, matricula);
+
+    for (int dist = 0; dist <= distMax; dist++) {
+        // Posição vazia, ou ocupante mais perto de casa do que a matrícula estaria: não existe
+        if (tabela->matriculas[index] == VAZIO || tabela->distancias[index] < dist) {
+            break;
+        }
+
+        // Matrícula encontrada
+        if (tabela->matriculas[index] == matricula) {
+            return index;
+        }
+
+        index = sonda(tabela->capacidade, index, 0, 1);
+    }
+
+    return NAO_EXISTE;
+}
+
+// Remove uma matrícula, puxando para trás os elementos seguintes do agrupamento
+long int removeMat (HashTable *tabela, long int matricula) {
+    int index = busca(tabela, matricula);
+
+    // Matrícula não encontrada
+    if (index == NAO_EXISTE) {
+        return NAO_EXISTE;
+    }
+
+    unsigned int atual = index;
+    unsigned int prox = sonda(tabela->capacidade, atual, 0, 1);
+
+    // Backward-shift: enquanto o próximo elemento estiver fora da posição ideal, ele volta uma posição
+    while (tabela->matriculas[prox] != VAZIO && tabela->distancias[prox] > 0) {
+        tabela->matriculas[atual] = tabela->matriculas[prox];
+        tabela->distancias[atual] = tabela->distancias[prox] - 1;
+        atual = prox;
+        prox = sonda(tabela->capacidade, atual, 0, 1);
+    }
+
+    tabela->matriculas[atual] = VAZIO;
+    tabela->distancias[atual] = 0;
+    tabela->qtdMat--;
+
+    return matricula;
+}
+
+#else
+
+// Coloca uma matrícula que não está na tabela na primeira posição livre (vazia ou lápide) da sequência. Retorna -1 se posicionou
+long int posiciona (HashTable *tabela, long int matricula) {
+    unsigned int index = inicio(tabela->capacidade, matricula);
+    unsigned int passo = passoDuplo(matricula);
+
+    for (int i = 0; i < tabela->capacidade; i++) {
+        unsigned int probeIndex = sonda(tabela->capacidade, index, passo, i);
+        if (tabela->matriculas[probeIndex] < 0) {
+            tabela->qtdApagados -= tabela->matriculas[probeIndex] == APAGADO;
+            tabela->matriculas[probeIndex] = matricula;
+            tabela->qtdMat++;
+            return -1;
+        }
+    }
+
+    return matricula;
+}
+
+// Função para inserir uma matrícula na hash table
+int insere (HashTable *tabela, long int matricula) {
+    // Verifica a taxa de ocupação; se só as lápides passaram do limite, reconstrói com a mesma capacidade
+    if (tabela->qtdMat + 1 > tabela->capacidade * tabela->ocupMax) {
+        redimensiona(tabela, tabela->capacidade * 2);
+    }
+    else if (tabela->qtdMat + tabela->qtdApagados + 1 > tabela->capacidade * (1 + tabela->ocupMax) / 2) {
+        redimensiona(tabela, tabela->capacidade);
+    }
+
+    unsigned int index = inicio(tabela->capacidade, matricula);
+    unsigned int passo = passoDuplo(matricula);
+    int lapide = -1; // Primeira lápide da sequência, reaproveitada se a matrícula não existir
+
+    for (int i = 0; i < tabela->capacidade; i++) {
+        unsigned int probeIndex = sonda(tabela->capacidade, index, passo, i);
+        long int ocupante = tabela->matriculas[probeIndex];
+
+        // Index vazio: a matrícula não existe
+        if (ocupante == VAZIO) {
+            if (lapide != -1) {
+                probeIndex = lapide;
+                tabela->qtdApagados--;
+            }
+            tabela->matriculas[probeIndex] = matricula;
+            tabela->qtdMat++;
+            return SUCESSO;
+        }
+
+        if (ocupante == APAGADO) {
+            if (lapide == -1) {
+                lapide = probeIndex;
+            }
+            continue;
+        }
+
+        if (ocupante == matricula) {
+            return EXISTE; // Matrícula já cadastrada
+        }
+    }
+
+    // Sequência inteira sem posição vazia: só resta a lápide
+    if (lapide != -1) {
+        tabela->matriculas[lapide] = matricula;
+        tabela->qtdApagados--;
+        tabela->qtdMat++;
+        return SUCESSO;
+    }
+
+    return TABELA_CHEIA;
+}
+
+// Função para buscar uma matrícula na hash table
+int busca (HashTable *tabela, long int matricula) {
+    unsigned int index = inicio(tabela->capacidade, matricula);
+    unsigned int passo = passoDuplo(matricula);
+
+    for (int i = 0; i < tabela->capacidade; i++) {
+        unsigned int probeIndex = sonda(tabela->capacidade, index, passo, i);
+
+        // Matrícula encontrada
+        if (tabela->matriculas[probeIndex] == matricula) {
+            return probeIndex;
+        }
+
+        // Matrícula não cadastrada (as lápides são puladas)
+        if (tabela->matriculas[probeIndex] == VAZIO) {
+            break;
+        }
+    }
+
+    return NAO_EXISTE;
+}
+
+// Remove uma matrícula: lápide, ou na sondagem linear, fechamento do buraco
+long int removeMat (HashTable *tabela, long int matricula) {
+    int buraco = busca(tabela, matricula);
+
+    // Matrícula não encontrada
+    if (buraco == NAO_EXISTE) {
+        return NAO_EXISTE;
+    }
+
+    tabela->qtdMat--;
+
+#if estrategia == SONDAGEM_LINEAR
+    // Cada elemento seguinte do agrupamento cuja posição ideal não está entre o buraco e ele vai para o buraco
+    int mascara = tabela->capacidade - 1;
+    int j = buraco;
+    while (1) {
+        j = sonda(tabela->capacidade, j, 0, 1);
+        if (tabela->matriculas[j] == VAZIO) {
+            break; // Fim do agrupamento
+        }
+
+        int ideal = hash(tabela->capacidade, tabela->matriculas[j]);
+        if (((j - ideal) & mascara) >= ((j - buraco) & mascara)) {
+            tabela->matriculas[buraco] = tabela->matriculas[j];
+            buraco = j;
+        }
+    }
+    tabela->matriculas[buraco] = VAZIO;
+#else
+    tabela->matriculas[buraco] = APAGADO;
+    tabela->qtdApagados++;
+#endif
+
+    return matricula;
+}
+
+#endif
+
+// Redistribui as matrículas em vetores novos com "capacidade" posições (a mesma capacidade limpa as lápides). Retorna 0 em caso de falha
+int redimensiona (HashTable *tabela, int capacidade) {
+    while (1) {
+        HashTable *nova = init_hash(capacidade, tabela->ocupMax);
+
+        if (nova == NULL) {
+            return 0;
+        }
+
+        // Re-hash dos elementos existentes
+        int ok = 1;
+        for (int i = 0; i < tabela->capacidade && ok; i++) {
+            if (tabela->matriculas[i] >= 0) {
+                ok = posiciona(nova, tabela->matriculas[i]) == -1;
+            }
+        }
+
+        // Alguma distância do Robin Hood estourou: tenta com o dobro
+        if (!ok) {
+            liberaHash(nova);
+            capacidade *= 2;
+            continue;
+        }
+
+        // A tabela passa a usar os vetores novos
+        free(tabela->matriculas);
+        free(tabela->distancias);
+        tabela->matriculas = nova->matriculas;
+        tabela->distancias = nova->distancias;
+        tabela->capacidade = nova->capacidade;
+        tabela->qtdMat = nova->qtdMat;
+        tabela->qtdApagados = 0;
+        free(nova);
+
+        return 1;
+    }
+}
+
+// Função para imprimir as matrículas
+void imprime (HashTable *tabela) {
+    float txOcup = (float)tabela->qtdMat / tabela->capacidade;
+    printf("qtdMat = %d | Capacidade = %d | txOcup = %.2f | Lápides = %d\n", tabela->qtdMat, tabela->capacidade, txOcup, tabela->qtdApagados);
+    for (int i = 0; i < tabela->capacidade; i++) {
+        if (tabela->matriculas[i] >= 0) {
+            printf("Índice %d: %ld\n", i, tabela->matriculas[i]);
+        }
+    }
+}
+
+// Libera a memória da tabela
+void liberaHash (HashTable *tabela) {
+    free(tabela->matriculas);
+    free(tabela->distancias);
+    free(tabela);
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Compara dois tempos (qsort)
+int comparaTempos (const void *a, const void *b) {
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Matrícula de 11 dígitos do identificador id (distintas para id < 9 * 10^10: 7919 e 1000003 são primos com 9 * 10^10)
+long int matriculaDe (long int id) {
+    return 10000000000L + id * 7919L % 90000000000L * 1000003L % 90000000000L;
+}
+
+// Executa a t-ésima operação da carga. Retorna 1 se o resultado foi o esperado
+int executa (HashTable *tabela, Bancada *b, carga c, int t) {
+    // Achadas: as vivas em ordem (o vetor de vivas é lido em sequência e não soma uma falta de cache à busca;
+    // as posições na tabela continuam espalhadas pelo hash). Ausentes: identificadores muito acima dos usados
+    long int ausente = 80000000000L + t;
+    int fase = t; // Rotatividade: par remove, ímpar insere
+
+    if (c == MISTA) {
+        int r = t % 10;
+        c = (r < 4) ? BUSCA_ACHADA : (r < 8) ? BUSCA_AUSENTE : ROTATIVIDADE;
+        if (r >= 8) {
+            fase = r - 8; // 0: remoção, 1: inserção (t continua escolhendo a viva das buscas)
+        }
+    }
+
+    switch (c) {
+        case INSERCAO:
+            b->vivas[b->qtdVivas++] = b->proxima;
+            return insere(tabela, matriculaDe(b->proxima++)) == SUCESSO;
+        case BUSCA_ACHADA:
+            return busca(tabela, matriculaDe(b->vivas[(unsigned int)t % b->qtdVivas])) != NAO_EXISTE;
+        case BUSCA_AUSENTE:
+            return busca(tabela, matriculaDe(ausente)) == NAO_EXISTE;
+        default:
+            // Rotatividade: remove a viva mais antiga e, na operação seguinte, insere uma nova no lugar dela
+            if (fase % 2 == 0) {
+                return removeMat(tabela, matriculaDe(b->vivas[b->cursor])) != NAO_EXISTE;
+            }
+            b->vivas[b->cursor] = b->proxima;
+            b->cursor = (b->cursor + 1) % b->qtdVivas;
+            return insere(tabela, matriculaDe(b->proxima++)) == SUCESSO;
+    }
+}
+
+// Roda "ops" operações da carga, medindo a vazão e a latência de uma a cada periodoLatencia. Soma os resultados inesperados em erros
+Medida mede (HashTable *tabela, Bancada *b, carga c, int ops, float latencias[], double custoRelogio, int *erros) {
+    int amostras = 0;
+    double inicioTotal = agora();
+
+    for (int t = 0; t < ops; t++) {
+        if (t % periodoLatencia == 0) {
+            double inicioOp = agora();
+            *erros += !executa(tabela, b, c, t);
+            latencias[amostras++] = (float)((agora() - inicioOp - custoRelogio) * 1e9);
+        }
+        else {
+            *erros += !executa(tabela, b, c, t);
+        }
+    }
+
+    Medida m;
+    m.mops = ops / (agora() - inicioTotal) / 1e6;
+    qsort(latencias, amostras, sizeof(float), comparaTempos);
+    m.p99 = latencias[(long int)amostras * 99 / 100];
+
+    return m;
+}
+
+// Bancada: todas as cargas para ocupações de 0.50 a 0.95 em uma tabela de 2^bits posições. Retorna os resultados inesperados
+int bancada (int bits, int ops) {
+    int capacidade = 1 << bits;
+    float ocupacoes[] = {0.50, 0.60, 0.70, 0.80, 0.85, 0.90, 0.95};
+    int qtdOcupacoes = sizeof(ocupacoes) / sizeof(ocupacoes[0]);
+    const char *nomes[] = {"inserção", "busca achada", "busca ausente", "rotatividade", "mista"};
+
+    Bancada b;
+    b.vivas = (long int *)malloc(sizeof(long int) * capacidade);
+    int maxAmostras = (capacidade > ops ? capacidade : ops) / periodoLatencia + 1;
+    float *latencias = (float *)malloc(sizeof(float) * maxAmostras);
+
+    // Verifica a alocação de memória
+    if (b.vivas == NULL || latencias == NULL) {
+        printf("Não foi possível alocar memória para a bancada.\n");
+        return -1;
+    }
+
+    // Custo de duas leituras do relógio, descontado das latências
+    double inicio = agora();
+    for (int i = 0; i < 100000; i++) {
+        agora();
+    }
+    double custoRelogio = (agora() - inicio) / 100000;
+
+    printf("Estratégia: %s | capacidade 2^%d (%.0f MB) | %d operações por carga | vazão em Mop/s e p99 em ns\n", nomeEstrategia, bits,
+           capacidade * sizeof(long int) / 1048576.0, ops);
+    printf("ocup. ");
+    for (int c = 0; c < qtdCargas; c++) {
+        printf("| %-17s", nomes[c]);
+    }
+    printf("\n");
+
+    int erros = 0;
+    for (int o = 0; o < qtdOcupacoes; o++) {
+        // ocupMax logo acima da ocupação medida: a tabela não cresce durante as cargas
+        HashTable *tabela = init_hash(capacidade, ocupacoes[o] + 0.01);
+        if (tabela == NULL) {
+            return -1;
+        }
+        b.qtdVivas = 0;
+        b.proxima = 0;
+        b.cursor = 0;
+
+        printf("%.2f  ", ocupacoes[o]);
+        for (int c = 0; c < qtdCargas; c++) {
+            int n = (c == INSERCAO) ? (int)(capacidade * ocupacoes[o]) : ops;
+            Medida m = mede(tabela, &b, c, n, latencias, custoRelogio, &erros);
+            printf("| %6.1f %8.0f  ", m.mops, m.p99);
+        }
+        printf("\n");
+
+        // Conferência: todas as vivas alcançáveis e nenhuma capacidade extra
+        for (int i = 0; i < b.qtdVivas; i++) {
+            erros += busca(tabela, matriculaDe(b.vivas[i])) == NAO_EXISTE;
+        }
+        erros += tabela->qtdMat != b.qtdVivas || tabela->capacidade != capacidade;
+
+        liberaHash(tabela);
+    }
+    printf("Resultados inesperados: %d\n", erros);
+
+    free(b.vivas);
+    free(latencias);
+
+    return erros;
+}
+
+int main (int argc, char *argv[]) {
+    int bits = (argc > 1) ? atoi(argv[1]) : 22;
+    int ops = (argc > 2) ? atoi(argv[2]) : 1000000;
+
+    if (bits < 4 || bits > 28 || ops <= 0) {
+        printf("Uso: %s [bits da capacidade (4 a 28)] [operações por carga]\n", argv[0]);
+        return 1;
+    }
+
+    // Inicializa a hash table
+    HashTable *tabela = init_hash(capMinima, ocupMaxPadrao);
+    if (tabela == NULL) {
+        return 1;
+    }
+
+    long int retorno;
+
+    // Inserindo números de matrícula
+    printf("Inserção (%s): \n", nomeEstrategia);
+    long int matriculas[] = {12345678901, 12345678901, 12335678901, 23456789012, 34567890123, 45678901234, 12345678905, 12345678906};
+    int qtd = sizeof(matriculas) / sizeof(matriculas[0]);
+
+    for (int i = 0; i < qtd; i++) {
+        retorno = insere(tabela, matriculas[i]);
+
+        if (retorno == EXISTE) {
+            printf("Matrícula %ld já cadastrada.\n", matriculas[i]);
+        }
+        else if (retorno == TABELA_CHEIA) {
+            printf("Tabela cheia. Matrícula %ld não cadastrada.\n", matriculas[i]);
+        }
+    }
+
+    imprime(tabela);
+    printf("\n");
+
+    // Removendo matrícula
+    printf("Remoção: \n");
+    long int matricula = 23456789012;
+    retorno = removeMat(tabela, matricula);
+    if (retorno != NAO_EXISTE) {
+        printf("Matrícula %ld removida.\n", retorno);
+        imprime(tabela);
+    }
+    else {
+        printf("Matrícula %ld não encontrada.\n", matricula);
+    }
+    printf("\n");
+
+    liberaHash(tabela);
+
+    // Bancada de medição
+    return bancada(bits, ops) != 0;
+}
@@ -0,0 +1,389 @@
+// ## Hash Table com Redimensionamento Incremental ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+// Constantes
+#define tamTab 8 // Tamanho inicial da tabela (potência de 2)
+#define ocupMax 0.80 // Taxa de ocupação máxima da tabela
+#define passoMigracao 16 // Posições da tabela antiga migradas a cada operação
+#define VAZIO 0 // Posição livre (matrículas são positivas)
+#define APAGADO -1 // Matrícula removida da tabela antiga antes de ser migrada
+
+/*
+Obs.: no hashTable.c, o insere que ultrapassa ocupMax chama o redimensiona, que reinsere todas as matrículas antes de retornar. Com 100 milhões de matrículas, essa única inserção demora segundos.
+
+Aqui, ao ultrapassar ocupMax, a tabela aloca o vetor novo (com o dobro da capacidade) e mantém o antigo vivo. Cada insere, busca e removeMat migra no máximo passoMigracao posições do vetor antigo, em ordem (posMigracao indica até onde foi). Durante a migração:
+- insere coloca sempre no vetor novo, depois de verificar que a matrícula não está em nenhum dos dois;
+- busca procura no vetor novo e, se não encontrar, no antigo. No antigo, só vale um achado em posição ainda não migrada (>= posMigracao): as posições já migradas não são apagadas do vetor antigo, para não quebrar as sequências de sondagem das que faltam;
+- removeMat remove do vetor novo (deslocamento para trás, sem marcas) ou marca APAGADO no antigo, e a migração ignora as APAGADO.
+
+Como o vetor novo começa com metade da ocupação máxima e cada inserção migra passoMigracao >= 2 posições, a migração termina antes de o vetor novo encher. Se mesmo assim a ocupação chegar ao limite durante uma migração, ela é concluída de uma vez.
+
+VAZIO é 0 (e não -1 como no hashTable.c) para que o vetor novo venha do calloc: em vetores grandes o sistema entrega páginas já zeradas sob demanda, e a alocação não precisa percorrer o vetor inteiro escrevendo -1, o que seria outra pausa proporcional ao tamanho.
+*/
+
+// Tipos enumerados
+typedef enum status {
+    SUCESSO = 0,
+    EXISTE = -1,
+    NAO_EXISTE = -2,
+    TABELA_CHEIA = -3,
+    INVALIDA = -4
+} status;
+
+// Estrutura da Hash
+typedef struct HashTable {
+    long int *matriculas; // Vetor atual
+    int capacidade;
+    long int *antigas; // Vetor em migração (NULL se não há migração)
+    int capAntiga;
+    int posMigracao; // Posições [0, posMigracao) do vetor antigo já migradas
+    int qtdMat; // Quantidade de matrículas cadastradas (nos dois vetores)
+    int incremental; // 0: migra tudo de uma vez, como o redimensiona do hashTable.c
+} HashTable;
+
+// Cabeçalho
+HashTable *init_hash (int incremental);
+unsigned int hash (int capacidade, long int matricula);
+unsigned int ProbingLinear (int capacidade, unsigned int index, int i);
+int insere (HashTable *tabela, long int matricula);
+int redimensiona (HashTable *tabela);
+int busca (HashTable *tabela, long int matricula);
+long int removeMat (HashTable *tabela, long int matricula);
+void liberaHash (HashTable *tabela);
+
+// Inicializa a tabela
+HashTable *init_hash (int incremental) {
+    // Aloca memória para a tabela
+    HashTable *tabela = (HashTable *)malloc(sizeof(HashTable));
+
+    // Verifica a alocação de memória
+    if (tabela == NULL) {
+        printf("Não foi possível alocar memória para a tabela.\n");
+        return NULL;
+    }
+
+    // Aloca memória para as matrículas, já com VAZIO (0)
+    tabela->matriculas = (long int *)calloc(tamTab, sizeof(long int));
+
+    // Verifica a alocação de memória
+    if (tabela->matriculas == NULL) {
+        printf("Não foi possível alocar memória para as matrículas.\n");
+        free(tabela);
+        return NULL;
+    }
+
+    tabela->capacidade = tamTab;
+    tabela->antigas = NULL;
+    tabela->capAntiga = 0;
+    tabela->posMigracao = 0;
+    tabela->qtdMat = 0;
+    tabela->incremental = incremental;
+
+    return tabela;
+}
+
+// Função hash: Fibonacci, com os bits mais altos do produto (capacidade potência de 2)
+unsigned int hash (int capacidade, long int matricula) {
+    return (unsigned int)(((uint64_t)matricula * 11400714819323198485ull) >> (64 - __builtin_ctz(capacidade)));
+}
+
+// Calcula um novo índice em caso de colisão
+unsigned int ProbingLinear (int capacidade, unsigned int index, int i) {
+    return (index + i) & (capacidade - 1);
+}
+
+// Coloca a matrícula na primeira posição VAZIO do vetor (sem verificar duplicidade)
+void posiciona (long int *vetor, int capacidade, long int matricula) {
+    unsigned int index = hash(capacidade, matricula);
+
+    while (vetor[index] != VAZIO) {
+        index = ProbingLinear(capacidade, index, 1);
+    }
+    vetor[index] = matricula;
+}
+
+// Procura a matrícula no vetor. Retorna a posição ou NAO_EXISTE (APAGADO não interrompe a sondagem)
+int buscaVetor (long int *vetor, int capacidade, long int matricula) {
+    unsigned int index = hash(capacidade, matricula);
+
+    for (int i = 0; i < capacidade; i++) {
+        if (vetor[index] == matricula) {
+            return index;
+        }
+        if (vetor[index] == VAZIO) {
+            break;
+        }
+        index = ProbingLinear(capacidade, index, 1);
+    }
+
+    return NAO_EXISTE;
+}
+
+// Migra até "quantidade" posições do vetor antigo para o novo
+void migra (HashTable *tabela, int quantidade) {
+    if (tabela->antigas == NULL) {
+        return;
+    }
+
+    int fim = tabela->posMigracao + quantidade;
+    if (fim > tabela->capAntiga) {
+        fim = tabela->capAntiga;
+    }
+
+    for (int i = tabela->posMigracao; i < fim; i++) {
+        long int matricula = tabela->antigas[i];
+        if (matricula != VAZIO && matricula != APAGADO) {
+            posiciona(tabela->matriculas, tabela->capacidade, matricula);
+        }
+    }
+    tabela->posMigracao = fim;
+
+    // Migração concluída: o vetor antigo é liberado
+    if (tabela->posMigracao == tabela->capAntiga) {
+        free(tabela->antigas);
+        tabela->antigas = NULL;
+        tabela->capAntiga = 0;
+        tabela->posMigracao = 0;
+    }
+}
+
+// Inicia a migração para um vetor com o dobro da capacidade. Retorna 0 em caso de falha
+int redimensiona (HashTable *tabela) {
+    // Conclui a migração anterior, se houver
+    migra(tabela, tabela->capAntiga);
+
+    long int *novo = (long int *)calloc((size_t)tabela->capacidade * 2, sizeof(long int));
+
+    // Verifica a alocação de memória
+    if (novo == NULL) {
+        printf("Não foi possível alocar memória para as matrículas.\n");
+        return 0;
+    }
+
+    tabela->antigas = tabela->matriculas;
+    tabela->capAntiga = tabela->capacidade;
+    tabela->posMigracao = 0;
+    tabela->matriculas = novo;
+    tabela->capacidade *= 2;
+
+    // Modo síncrono: migra tudo agora
+    if (!tabela->incremental) {
+        migra(tabela, tabela->capAntiga);
+    }
+
+    return 1;
+}
+
+// Função para buscar uma matrícula. Retorna a posição no vetor atual ou no antigo (a partir de capacidade) ou NAO_EXISTE
+int busca (HashTable *tabela, long int matricula) {
+    // 0 e -1 são VAZIO e APAGADO, nunca matrículas cadastradas
+    if (matricula <= 0) {
+        return NAO_EXISTE;
+    }
+
+    migra(tabela, passoMigracao);
+
+    int pos = buscaVetor(tabela->matriculas, tabela->capacidade, matricula);
+    if (pos != NAO_EXISTE) {
+        return pos;
+    }
+
+    // Vetor antigo: só valem as posições ainda não migradas
+    if (tabela->antigas != NULL) {
+        pos = buscaVetor(tabela->antigas, tabela->capAntiga, matricula);
+        if (pos >= tabela->posMigracao) {
+            return tabela->capacidade + pos;
+        }
+    }
+
+    return NAO_EXISTE;
+}
+
+// Função para inserir uma matrícula na hash table
+int insere (HashTable *tabela, long int matricula) {
+    // Só matrículas positivas: 0 e -1 se confundiriam com VAZIO e APAGADO
+    if (matricula <= 0) {
+        return INVALIDA;
+    }
+
+    // Matrícula já cadastrada (a busca também faz um passo da migração)
+    if (busca(tabela, matricula) != NAO_EXISTE) {
+        return EXISTE;
+    }
+
+    // Verifica a taxa de ocupação do vetor atual
+    float txOcup = (float)(tabela->qtdMat + 1) / tabela->capacidade;
+    if (txOcup > ocupMax && !redimensiona(tabela)) {
+        return TABELA_CHEIA;
+    }
+
+    posiciona(tabela->matriculas, tabela->capacidade, matricula);
+    tabela->qtdMat++;
+
+    return SUCESSO;
+}
+
+// Remove a posição do vetor atual, puxando para trás os elementos que a sondagem linear deslocou
+void removeDoVetor (long int *vetor, int capacidade, int pos) {
+    int vazia = pos;
+    int i = ProbingLinear(capacidade, pos, 1);
+
+    while (vetor[i] != VAZIO) {
+        unsigned int ideal = hash(capacidade, vetor[i]);
+
+        // O elemento pode ocupar a posição vazia se o ideal dele não está no intervalo circular (vazia, i]
+        int distVazia = (vazia - ideal) & (capacidade - 1);
+        int distAtual = (i - ideal) & (capacidade - 1);
+        if (distVazia < distAtual) {
+            vetor[vazia] = vetor[i];
+            vazia = i;
+        }
+        i = ProbingLinear(capacidade, i, 1);
+    }
+
+    vetor[vazia] = VAZIO;
+}
+
+// Função para remover uma matrícula
+long int removeMat (HashTable *tabela, long int matricula) {
+    int pos = busca(tabela, matricula);
+
+    // Matrícula não encontrada
+    if (pos == NAO_EXISTE) {
+        return NAO_EXISTE;
+    }
+
+    if (pos < tabela->capacidade) {
+        removeDoVetor(tabela->matriculas, tabela->capacidade, pos);
+    }
+    else {
+        tabela->antigas[pos - tabela->capacidade] = APAGADO;
+    }
+    tabela->qtdMat--;
+
+    return matricula;
+}
+
+// Libera a memória da tabela
+void liberaHash (HashTable *tabela) {
+    free(tabela->matriculas);
+    free(tabela->antigas);
+    free(tabela);
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Compara dois tempos (qsort)
+int comparaTempos (const void *a, const void *b) {
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Insere n matrículas medindo a latência de cada inserção e imprime os percentis
+void medeLatencias (int incremental, long int chaves[], int n) {
+    HashTable *tabela = init_hash(incremental);
+    float *latencias = (float *)malloc(sizeof(float) * n);
+
+    // Verifica a alocação de memória
+    if (tabela == NULL || latencias == NULL) {
+        printf("Não foi possível alocar memória.\n");
+        return;
+    }
+
+    double inicioTotal = agora();
+    for (int i = 0; i < n; i++) {
+        double inicio = agora();
+        insere(tabela, chaves[i]);
+        latencias[i] = (float)((agora() - inicio) * 1e9);
+    }
+    double total = agora() - inicioTotal;
+
+    // Conferência: todas as matrículas alcançáveis, e metade delas removível
+    int erros = 0;
+    for (int i = 0; i < n; i++) {
+        erros += busca(tabela, chaves[i]) == NAO_EXISTE;
+    }
+    for (int i = 0; i < n; i += 2) {
+        erros += removeMat(tabela, chaves[i]) == NAO_EXISTE;
+    }
+    for (int i = 0; i < n; i++) {
+        erros += (busca(tabela, chaves[i]) != NAO_EXISTE) != (i % 2 == 1);
+    }
+
+    qsort(latencias, n, sizeof(float), comparaTempos);
+    printf("%-11s total %6.2f s | p50 %5.0f ns | p99 %6.0f ns | p99.9 %6.0f ns | p99.99 %9.0f ns | máx %11.0f ns | erros %d\n",
+           incremental ? "Incremental" : "Síncrono", total, latencias[(long int)n * 50 / 100], latencias[(long int)n * 99 / 100],
+           latencias[(long int)n * 999 / 1000], latencias[(long int)n * 9999 / 10000], latencias[n - 1], erros);
+
+    liberaHash(tabela);
+    free(latencias);
+}
+
+int main (int argc, char *argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 1 << 23;
+
+    if (n <= 0) {
+        printf("Quantidade inválida.\n");
+        return 1;
+    }
+
+    // Demonstração: inserção, busca e remoção atravessando vários redimensionamentos
+    HashTable *tabela = init_hash(1);
+
+    // Verifica a alocação de memória
+    if (tabela == NULL) {
+        return 1;
+    }
+
+    printf("Inserção: \n");
+    long int matriculas[] = {12345678901, 12345678901, 12335678901, 23456789012, 34567890123, 45678901234, 12345678905, 12345678906, 0};
+    int qtd = sizeof(matriculas) / sizeof(matriculas[0]);
+
+    for (int i = 0; i < qtd; i++) {
+        long int retorno = insere(tabela, matriculas[i]);
+
+        if (retorno == EXISTE) {
+            printf("Matrícula %ld já cadastrada.\n", matriculas[i]);
+        }
+        else if (retorno == TABELA_CHEIA) {
+            printf("Tabela cheia. Matrícula %ld não cadastrada.\n", matriculas[i]);
+        }
+        else if (retorno == INVALIDA) {
+            printf("Matrícula %ld inválida (precisa ser positiva).\n", matriculas[i]);
+        }
+    }
+    printf("qtdMat = %d | Capacidade = %d | Migração em andamento: %s\n\n", tabela->qtdMat, tabela->capacidade, tabela->antigas ? "sim" : "não");
+    liberaHash(tabela);
+
+    // Latência de inserção com redimensionamento síncrono e incremental
+    long int *chaves = (long int *)malloc(sizeof(long int) * n);
+
+    // Verifica a alocação de memória
+    if (chaves == NULL) {
+        printf("Não foi possível alocar memória para as matrículas.\n");
+        return 1;
+    }
+
+    // Matrículas distintas e espalhadas: i * m mod 9 * 10^10 é uma bijeção (m primo com 2, 3 e 5)
+    for (int i = 0; i < n; i++) {
+        chaves[i] = 10000000000L + (long int)i * 7919L * 1000003L % 90000000000L;
+    }
+
+    printf("Latência de %d inserções:\n", n);
+    medeLatencias(0, chaves, n);
+    medeLatencias(1, chaves, n);
+
+    free(chaves);
+
+    return 0;
+}
@@ -0,0 +1,470 @@
+// ## Hash Table como Mapa (Matrícula -> Registro) com Valores Pequenos na Própria Tabela ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+// Constantes
+#define tamTab 8 // Tamanho inicial da tabela (potência de 2)
+#define ocupMax 0.80 // Taxa de ocupação máxima da tabela
+#define tamInline 16 // Valores de até 16 bytes ficam ao lado da matrícula
+#define blocosPorSlab 1024 // Valores grandes alocados em lotes de 1024
+
+/*
+Obs.: o hashTable.c é um conjunto: guarda só as matrículas. Para chegar ao registro do aluno era preciso uma segunda estrutura e uma segunda busca. Aqui cada posição da tabela é uma Entrada com a matrícula e o valor:
+- Valores de até tamInline bytes ficam dentro da própria Entrada (24 bytes no total), então a mesma sondagem que acha a matrícula já traz o valor na mesma linha de cache;
+- Valores maiores ficam em um Pool: blocos de tamanho fixo alocados em slabs de blocosPorSlab, com lista de livres. A Entrada guarda só o ponteiro para o bloco. Como o redimensiona move apenas as Entradas, o ponteiro devolvido por get continua válido até a remoção da matrícula.
+
+Operações (uma única sondagem cada):
+- get: ponteiro para o valor ou NULL;
+- put: insere se a matrícula não existe (EXISTE caso contrário, como o insere);
+- upsert: insere ou sobrescreve;
+- get_or_insert: ponteiro para o valor, inserindo um valor zerado se a matrícula não existia.
+*/
+
+// Tipos enumerados
+typedef enum status {
+    SUCESSO = 0,
+    EXISTE = -1,
+    NAO_EXISTE = -2,
+    TABELA_CHEIA = -3,
+    ATUALIZADO = 1
+} status;
+
+// Posição da tabela: matrícula (-1 = vazio) e valor (inline ou ponteiro para o pool)
+typedef struct Entrada {
+    long int matricula;
+    union {
+        unsigned char dados[tamInline];
+        void *externo;
+    } valor;
+} Entrada;
+
+// Pool de blocos de tamanho fixo para os valores grandes
+typedef struct Pool {
+    size_t tamBloco;
+    void *livres; // Lista de blocos livres (o próprio bloco guarda o próximo)
+    void **slabs; // Lotes alocados, para liberar no final
+    int qtdSlabs;
+    int capSlabs;
+} Pool;
+
+// Estrutura do Mapa
+typedef struct Mapa {
+    Entrada *entradas;
+    int qtdMat; // Quantidade de matrículas cadastradas
+    int capacidade; // Quantidade de espaços disponíveis (potência de 2)
+    size_t tamValor; // Tamanho do valor associado a cada matrícula
+    Pool pool; // Usado só se tamValor > tamInline
+} Mapa;
+
+// Cabeçalho
+Mapa *init_mapa (size_t tamValor);
+unsigned int hash (int capacidade, long int matricula);
+unsigned int ProbingLinear (int capacidade, unsigned int index, int i);
+void *get (Mapa *mapa, long int matricula);
+int put (Mapa *mapa, long int matricula, const void *valor);
+int upsert (Mapa *mapa, long int matricula, const void *valor);
+void *get_or_insert (Mapa *mapa, long int matricula, int *inseriu);
+int redimensiona (Mapa *mapa);
+long int removeMat (Mapa *mapa, long int matricula);
+void liberaMapa (Mapa *mapa);
+
+// Pega um bloco livre do pool, alocando um novo slab se necessário. Retorna NULL em caso de falha
+void *alocaBloco (Pool *pool) {
+    if (pool->livres == NULL) {
+        // Cresce o vetor de slabs
+        if (pool->qtdSlabs == pool->capSlabs) {
+            int novaCap = pool->capSlabs ? pool->capSlabs * 2 : 8;
+            void **novos = (void **)realloc(pool->slabs, sizeof(void *) * novaCap);
+
+            // Verifica a alocação de memória
+            if (novos == NULL) {
+                printf("Não foi possível alocar memória para o pool.\n");
+                return NULL;
+            }
+            pool->slabs = novos;
+            pool->capSlabs = novaCap;
+        }
+
+        char *slab = (char *)malloc(pool->tamBloco * blocosPorSlab);
+
+        // Verifica a alocação de memória
+        if (slab == NULL) {
+            printf("Não foi possível alocar memória para o pool.\n");
+            return NULL;
+        }
+        pool->slabs[pool->qtdSlabs++] = slab;
+
+        // Encadeia os blocos do slab na lista de livres
+        for (int i = 0; i < blocosPorSlab; i++) {
+            void *bloco = slab + (size_t)i * pool->tamBloco;
+            *(void **)bloco = pool->livres;
+            pool->livres = bloco;
+        }
+    }
+
+    void *bloco = pool->livres;
+    pool->livres = *(void **)bloco;
+    return bloco;
+}
+
+// Devolve o bloco para a lista de livres
+void liberaBloco (Pool *pool, void *bloco) {
+    *(void **)bloco = pool->livres;
+    pool->livres = bloco;
+}
+
+// Inicializa o mapa
+Mapa *init_mapa (size_t tamValor) {
+    // Aloca memória para o mapa
+    Mapa *mapa = (Mapa *)malloc(sizeof(Mapa));
+
+    // Verifica a alocação de memória
+    if (mapa == NULL) {
+        printf("Não foi possível alocar memória para o mapa.\n");
+        return NULL;
+    }
+
+    // Aloca memória para as entradas
+    mapa->entradas = (Entrada *)malloc(sizeof(Entrada) * tamTab);
+
+    // Verifica a alocação de memória
+    if (mapa->entradas == NULL) {
+        printf("Não foi possível alocar memória para as entradas.\n");
+        free(mapa);
+        return NULL;
+    }
+
+    // Inicializa a tabela com valores inválidos
+    for (int i = 0; i < tamTab; i++) {
+        mapa->entradas[i].matricula = -1;
+    }
+
+    mapa->capacidade = tamTab;
+    mapa->qtdMat = 0;
+    mapa->tamValor = tamValor;
+
+    // Blocos do pool precisam caber o ponteiro da lista de livres
+    mapa->pool.tamBloco = (tamValor + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+    mapa->pool.livres = NULL;
+    mapa->pool.slabs = NULL;
+    mapa->pool.qtdSlabs = 0;
+    mapa->pool.capSlabs = 0;
+
+    return mapa;
+}
+
+// Função hash: Fibonacci, com os bits mais altos do produto (capacidade potência de 2)
+unsigned int hash (int capacidade, long int matricula) {
+    return (unsigned int)(((uint64_t)matricula * 11400714819323198485ull) >> (64 - __builtin_ctz(capacidade)));
+}
+
+// Calcula um novo índice em caso de colisão
+unsigned int ProbingLinear (int capacidade, unsigned int index, int i) {
+    return (index + i) & (capacidade - 1);
+}
+
+// Endereço do valor de uma entrada ocupada
+static inline void *valorDe (Mapa *mapa, Entrada *e) {
+    return (mapa->tamValor <= tamInline) ? (void *)e->valor.dados : e->valor.externo;
+}
+
+// Sondagem única: posição da matrícula ou a posição vazia onde ela entraria
+static inline unsigned int sonda (Mapa *mapa, long int matricula) {
+    unsigned int index = hash(mapa->capacidade, matricula);
+
+    while (mapa->entradas[index].matricula != -1 && mapa->entradas[index].matricula != matricula) {
+        index = ProbingLinear(mapa->capacidade, index, 1);
+    }
+
+    return index;
+}
+
+// Ponteiro para o valor da matrícula ou NULL
+void *get (Mapa *mapa, long int matricula) {
+    Entrada *e = &mapa->entradas[sonda(mapa, matricula)];
+    return (e->matricula == matricula) ? valorDe(mapa, e) : NULL;
+}
+
+// Ocupa a posição vazia "index" com a matrícula e um valor zerado. Retorna o ponteiro para o valor ou NULL em caso de falha
+void *ocupa (Mapa *mapa, unsigned int index, long int matricula) {
+    Entrada *e = &mapa->entradas[index];
+
+    if (mapa->tamValor > tamInline) {
+        e->valor.externo = alocaBloco(&mapa->pool);
+        if (e->valor.externo == NULL) {
+            return NULL;
+        }
+    }
+
+    e->matricula = matricula;
+    mapa->qtdMat++;
+
+    void *valor = valorDe(mapa, e);
+    memset(valor, 0, mapa->tamValor);
+    return valor;
+}
+
+// Ponteiro para o valor da matrícula, inserindo um valor zerado se ela não existir
+void *get_or_insert (Mapa *mapa, long int matricula, int *inseriu) {
+    unsigned int index = sonda(mapa, matricula);
+
+    if (inseriu != NULL) {
+        *inseriu = 0;
+    }
+
+    // Matrícula já cadastrada: a mesma sondagem devolve o valor
+    if (mapa->entradas[index].matricula == matricula) {
+        return valorDe(mapa, &mapa->entradas[index]);
+    }
+
+    // Redimensionar muda as posições: sonda de novo só neste caso
+    if ((float)(mapa->qtdMat + 1) / mapa->capacidade > ocupMax) {
+        if (!redimensiona(mapa)) {
+            return NULL;
+        }
+        index = sonda(mapa, matricula);
+    }
+
+    void *valor = ocupa(mapa, index, matricula);
+    if (valor != NULL && inseriu != NULL) {
+        *inseriu = 1;
+    }
+    return valor;
+}
+
+// Insere a matrícula com o valor. Retorna EXISTE se ela já estava cadastrada
+int put (Mapa *mapa, long int matricula, const void *valor) {
+    int inseriu;
+    void *destino = get_or_insert(mapa, matricula, &inseriu);
+
+    if (destino == NULL) {
+        return TABELA_CHEIA;
+    }
+    if (!inseriu) {
+        return EXISTE;
+    }
+
+    memcpy(destino, valor, mapa->tamValor);
+    return SUCESSO;
+}
+
+// Insere ou sobrescreve o valor da matrícula. Retorna SUCESSO (inserida) ou ATUALIZADO
+int upsert (Mapa *mapa, long int matricula, const void *valor) {
+    int inseriu;
+    void *destino = get_or_insert(mapa, matricula, &inseriu);
+
+    if (destino == NULL) {
+        return TABELA_CHEIA;
+    }
+
+    memcpy(destino, valor, mapa->tamValor);
+    return inseriu ? SUCESSO : ATUALIZADO;
+}
+
+// Dobra a capacidade e redistribui as entradas (os valores externos não se movem). Retorna 0 em caso de falha
+int redimensiona (Mapa *mapa) {
+    int capacidadeNova = mapa->capacidade * 2;
+    Entrada *novas = (Entrada *)malloc(sizeof(Entrada) * capacidadeNova);
+
+    // Verifica a alocação de memória
+    if (novas == NULL) {
+        printf("Não foi possível realocar memória para as entradas.\n");
+        return 0;
+    }
+
+    for (int i = 0; i < capacidadeNova; i++) {
+        novas[i].matricula = -1;
+    }
+
+    // Re-hash das entradas existentes
+    for (int i = 0; i < mapa->capacidade; i++) {
+        if (mapa->entradas[i].matricula != -1) {
+            unsigned int index = hash(capacidadeNova, mapa->entradas[i].matricula);
+            while (novas[index].matricula != -1) {
+                index = ProbingLinear(capacidadeNova, index, 1);
+            }
+            novas[index] = mapa->entradas[i];
+        }
+    }
+
+    free(mapa->entradas);
+    mapa->entradas = novas;
+    mapa->capacidade = capacidadeNova;
+
+    return 1;
+}
+
+// Remove a matrícula e o seu valor, puxando para trás os elementos deslocados
+long int removeMat (Mapa *mapa, long int matricula) {
+    unsigned int vazia = sonda(mapa, matricula);
+
+    // Matrícula não encontrada
+    if (mapa->entradas[vazia].matricula != matricula) {
+        return NAO_EXISTE;
+    }
+
+    if (mapa->tamValor > tamInline) {
+        liberaBloco(&mapa->pool, mapa->entradas[vazia].valor.externo);
+    }
+
+    // Deslocamento para trás: o elemento pode ocupar a posição vazia se o ideal dele não está no intervalo circular (vazia, i]
+    unsigned int mascara = mapa->capacidade - 1;
+    unsigned int i = ProbingLinear(mapa->capacidade, vazia, 1);
+    while (mapa->entradas[i].matricula != -1) {
+        unsigned int ideal = hash(mapa->capacidade, mapa->entradas[i].matricula);
+        if (((vazia - ideal) & mascara) < ((i - ideal) & mascara)) {
+            mapa->entradas[vazia] = mapa->entradas[i];
+            vazia = i;
+        }
+        i = ProbingLinear(mapa->capacidade, i, 1);
+    }
+
+    mapa->entradas[vazia].matricula = -1;
+    mapa->qtdMat--;
+
+    return matricula;
+}
+
+// Libera a memória do mapa e do pool
+void liberaMapa (Mapa *mapa) {
+    for (int i = 0; i < mapa->pool.qtdSlabs; i++) {
+        free(mapa->pool.slabs[i]);
+    }
+    free(mapa->pool.slabs);
+    free(mapa->entradas);
+    free(mapa);
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Registro pequeno (12 bytes: fica na própria tabela)
+typedef struct Resumo {
+    float cr; // Coeficiente de rendimento
+    int ano; // Ano de ingresso
+    int creditos;
+} Resumo;
+
+// Registro grande (64 bytes: fica no pool)
+typedef struct Aluno {
+    char nome[40];
+    float notas[4];
+    int ano;
+    int creditos;
+} Aluno;
+
+int main () {
+
+    // Mapa com registros grandes
+    Mapa *alunos = init_mapa(sizeof(Aluno));
+    Mapa *resumos = init_mapa(sizeof(Resumo));
+
+    // Verifica a alocação de memória
+    if (alunos == NULL || resumos == NULL) {
+        return 1;
+    }
+
+    printf("Inserção: \n");
+    long int matriculas[] = {12345678901, 12345678901, 12335678901, 23456789012, 34567890123};
+    const char *nomes[] = {"Ana", "Ana (duplicada)", "Bruno", "Carla", "Davi"};
+    int qtd = sizeof(matriculas) / sizeof(matriculas[0]);
+
+    for (int i = 0; i < qtd; i++) {
+        Aluno a;
+        memset(&a, 0, sizeof(a));
+        snprintf(a.nome, sizeof(a.nome), "%s", nomes[i]);
+        a.ano = 2020 + i;
+        a.notas[0] = 7.5f + i;
+
+        if (put(alunos, matriculas[i], &a) == EXISTE) {
+            printf("Matrícula %ld já cadastrada.\n", matriculas[i]);
+        }
+    }
+
+    // Atualização no lugar: o ponteiro devolvido aponta para o registro guardado
+    Aluno *a = (Aluno *)get(alunos, 23456789012);
+    if (a != NULL) {
+        a->creditos += 30;
+        printf("Matrícula 23456789012: %s, ingresso %d, %d créditos\n", a->nome, a->ano, a->creditos);
+    }
+
+    // get_or_insert: acumula créditos, criando o resumo na primeira vez
+    long int lancamentos[][2] = {{12345678901, 4}, {12335678901, 6}, {12345678901, 4}, {34567890123, 2}};
+    for (int i = 0; i < 4; i++) {
+        int inseriu;
+        Resumo *r = (Resumo *)get_or_insert(resumos, lancamentos[i][0], &inseriu);
+        if (r != NULL) {
+            r->creditos += (int)lancamentos[i][1];
+            printf("Matrícula %ld: %s, %d créditos\n", lancamentos[i][0], inseriu ? "resumo criado" : "resumo existente", r->creditos);
+        }
+    }
+
+    // upsert e remoção
+    Resumo novo = {8.7f, 2021, 100};
+    printf("upsert de 12335678901: %s\n", upsert(resumos, 12335678901, &novo) == ATUALIZADO ? "atualizado" : "inserido");
+    printf("Remoção de 12345678901: %s\n", removeMat(alunos, 12345678901) != NAO_EXISTE ? "removida" : "não encontrada");
+    printf("Busca de 12345678901: %s\n\n", get(alunos, 12345678901) != NULL ? "encontrada" : "não encontrada");
+
+    liberaMapa(alunos);
+    liberaMapa(resumos);
+
+    // Uma busca no mapa contra duas buscas (conjunto de matrículas + estrutura separada de registros)
+    int n = 1 << 22;
+    int consultas = 10000000;
+    Mapa *mapa = init_mapa(sizeof(Resumo));
+    Mapa *conjunto = init_mapa(0);
+    Mapa *separado = init_mapa(sizeof(Resumo));
+    long int *chaves = (long int *)malloc(sizeof(long int) * n);
+
+    // Verifica a alocação de memória
+    if (mapa == NULL || conjunto == NULL || separado == NULL || chaves == NULL) {
+        printf("Não foi possível alocar memória.\n");
+        return 1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        chaves[i] = 10000000000L + (long int)i * 7919L * 1000003L % 90000000000L;
+        Resumo r = {(float)(i % 100) / 10, 2000 + i % 25, i % 200};
+        put(mapa, chaves[i], &r);
+        put(conjunto, chaves[i], &r);
+        put(separado, chaves[i], &r);
+    }
+
+    long int soma[2] = {0, 0};
+    double inicio = agora();
+    for (int i = 0; i < consultas; i++) {
+        long int k = chaves[(unsigned int)(i * 2654435761u) % n];
+        if (get(conjunto, k) != NULL) {
+            soma[0] += ((Resumo *)get(separado, k))->creditos;
+        }
+    }
+    double tempoDuas = agora() - inicio;
+
+    inicio = agora();
+    for (int i = 0; i < consultas; i++) {
+        Resumo *r = (Resumo *)get(mapa, chaves[(unsigned int)(i * 2654435761u) % n]);
+        if (r != NULL) {
+            soma[1] += r->creditos;
+        }
+    }
+    double tempoUma = agora() - inicio;
+
+    printf("%d consultas em %d matrículas:\n", consultas, n);
+    printf("Conjunto + registros separados: %.1f ns (soma %ld)\n", tempoDuas * 1e9 / consultas, soma[0]);
+    printf("Mapa (valor inline):            %.1f ns (soma %ld)\n", tempoUma * 1e9 / consultas, soma[1]);
+
+    liberaMapa(mapa);
+    liberaMapa(conjunto);
+    liberaMapa(separado);
+    free(chaves);
+
+    return 0;
+}
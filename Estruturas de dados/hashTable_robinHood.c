@@ -0,0 +1,392 @@
+// ## Hash Table com Robin Hood Hashing e Remoção por Deslocamento para Trás ##
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Constantes e variáveis globais
+int tamTab = 5; // Tamanho inicial da tabela
+#define ocupMax 0.95 // Taxa de ocupação máxima da tabela (Robin Hood suporta ocupações altas)
+#define distMax 255 // Maior distância que cabe em um unsigned char
+
+/*
+Obs.: no probing linear do hashTable.c, a matrícula que chega primeiro fica com a posição, e as que colidem depois andam cada vez mais. Alguns elementos acabam muito longe da posição ideal, e a busca por uma matrícula ausente só para em um -1.
+
+No Robin Hood, cada posição guarda também a distância do elemento até a sua posição ideal (quantas posições ele andou). Durante a inserção, se o elemento que está sendo inserido já andou mais do que o ocupante da posição, eles trocam de lugar ("tira do rico e dá ao pobre") e a inserção continua com o ocupante. Isso equaliza as distâncias: a distância média é a mesma do probing linear, mas a distância máxima fica pequena mesmo com 90%+ de ocupação.
+
+Consequências:
+- Busca: se a distância do ocupante é menor que a distância já percorrida, a matrícula não está na tabela (ela teria tomado aquela posição). A busca para cedo, sem precisar chegar a um -1.
+- Remoção: em vez de reinserir os elementos seguintes com insere (como o reorganiza), os elementos seguintes do agrupamento são puxados uma posição para trás até encontrar uma posição vazia ou um elemento na posição ideal (distância 0).
+*/
+
+// Tipos enumerados
+typedef enum status {
+    SUCESSO = 0,
+    EXISTE = -1,
+    NAO_EXISTE = -2,
+    TABELA_CHEIA = -3
+} status;
+
+// Estrutura da Hash
+typedef struct HashTable {
+    long int *matriculas; // Array para armazenar os números de matrícula (-1 = vazio)
+    unsigned char *distancias; // Distância de cada elemento até a sua posição ideal
+    int qtdMat; // Quantidade de matrículas cadastradas
+    int capacidade; // Quantidade de espaços disponíveis
+} HashTable;
+
+// Cabeçalho
+HashTable *init_hash (int capacidade);
+unsigned int hash (int capacidade, long int matricula);
+unsigned int ProbingLinear (int capacidade, unsigned int index, int i);
+long int posiciona (HashTable *tabela, long int matricula);
+int insere (HashTable *tabela, long int matricula);
+int redimensiona (HashTable *tabela);
+int busca (HashTable *tabela, long int matricula);
+long int removeMat (HashTable *tabela, long int matricula);
+void liberaHash (HashTable *tabela);
+
+// Inicializa a tabela
+HashTable *init_hash (int capacidade) {
+    // Aloca memória para a tabela
+    HashTable *tabela = (HashTable *)malloc(sizeof(HashTable));
+
+    // Verifica a alocação de memória
+    if (tabela == NULL) {
+        printf("Não foi possível alocar memória para a tabela.\n");
+        return NULL;
+    }
+
+    // Aloca memória para as matrículas e distâncias
+    tabela->matriculas = (long int *)malloc(sizeof(long int) * capacidade);
+    tabela->distancias = (unsigned char *)calloc(capacidade, sizeof(unsigned char));
+
+    // Verifica a alocação de memória
+    if (tabela->matriculas == NULL || tabela->distancias == NULL) {
+        printf("Não foi possível alocar memória para as matrículas.\n");
+        free(tabela->matriculas);
+        free(tabela->distancias);
+        free(tabela);
+        return NULL;
+    }
+
+    // Inicializa a tabela com valores inválidos
+    for (int i = 0; i < capacidade; i++) {
+        tabela->matriculas[i] = -1;
+    }
+
+    tabela->capacidade = capacidade;
+    tabela->qtdMat = 0;
+
+    return tabela;
+}
+
+// Função hash: módulo da capacidade
+unsigned int hash (int capacidade, long int matricula) {
+    return matricula % capacidade;
+}
+
+// Calcula um novo índice em caso de colisão
+unsigned int ProbingLinear (int capacidade, unsigned int index, int i) {
+    return (index + i) % capacidade;
+}
+
+// Coloca uma matrícula sem verificar ocupação nem duplicidade.
+// Retorna -1 se tudo foi posicionado, ou a matrícula que ficou "na mão" se alguma distância estourou distMax
+long int posiciona (HashTable *tabela, long int matricula) {
+    unsigned int index = hash(tabela->capacidade, matricula);
+    int dist = 0;
+
+    while (dist <= distMax) {
+        // Posição vazia: a matrícula (ou o elemento deslocado) fica aqui
+        if (tabela->matriculas[index] == -1) {
+            tabela->matriculas[index] = matricula;
+            tabela->distancias[index] = (unsigned char)dist;
+            tabela->qtdMat++;
+            return -1;
+        }
+
+        // O ocupante andou menos: troca e continua inserindo o ocupante
+        if (tabela->distancias[index] < dist) {
+            long int tempMat = tabela->matriculas[index];
+            int tempDist = tabela->distancias[index];
+            tabela->matriculas[index] = matricula;
+            tabela->distancias[index] = (unsigned char)dist;
+            matricula = tempMat;
+            dist = tempDist;
+        }
+
+        index = ProbingLinear(tabela->capacidade, index, 1);
+        dist++;
+    }
+
+    return matricula;
+}
+
+// Função para inserir uma matrícula na hash table
+int insere (HashTable *tabela, long int matricula) {
+    // Matrícula já cadastrada
+    if (busca(tabela, matricula) != NAO_EXISTE) {
+        return EXISTE;
+    }
+
+    // Verifica a taxa de ocupação
+    float txOcup = (float)(tabela->qtdMat + 1) / tabela->capacidade;
+    if (txOcup > ocupMax && !redimensiona(tabela)) {
+        return TABELA_CHEIA;
+    }
+
+    // Distância estourou (muito improvável): dobra a tabela e posiciona o elemento que sobrou
+    while ((matricula = posiciona(tabela, matricula)) != -1) {
+        if (!redimensiona(tabela)) {
+            return TABELA_CHEIA;
+        }
+    }
+
+    return SUCESSO;
+}
+
+// Dobra a capacidade e redistribui os elementos. Retorna 0 em caso de falha
+int redimensiona (HashTable *tabela) {
+    int capacidade = tabela->capacidade * 2;
+
+    while (1) {
+        HashTable *nova = init_hash(capacidade);
+
+        if (nova == NULL) {
+            return 0;
+        }
+
+        // Re-hash dos elementos existentes
+        int ok = 1;
+        for (int i = 0; i < tabela->capacidade && ok; i++) {
+            if (tabela->matriculas[i] != -1) {
+                ok = posiciona(nova, tabela->matriculas[i]) == -1;
+            }
+        }
+
+        // Alguma distância estourou: tenta com o dobro
+        if (!ok) {
+            liberaHash(nova);
+            capacidade *= 2;
+            continue;
+        }
+
+        // A tabela passa a usar os vetores novos
+        free(tabela->matriculas);
+        free(tabela->distancias);
+        tabela->matriculas = nova->matriculas;
+        tabela->distancias = nova->distancias;
+        tabela->capacidade = nova->capacidade;
+        tabela->qtdMat = nova->qtdMat;
+        free(nova);
+
+        return 1;
+    }
+}
+
+// Função para buscar uma matrícula na hash table
+int busca (HashTable *tabela, long int matricula) {
+    unsigned int index = hash(tabela->capacidade, matricula);
+
+    for (int dist = 0; dist <= distMax; dist++) {
+        // Posição vazia, ou ocupante mais perto de casa do que a matrícula estaria: não existe
+        if (tabela->matriculas[index] == -1 || tabela->distancias[index] < dist) {
+            break;
+        }
+
+        // Matrícula encontrada
+        if (tabela->matriculas[index] == matricula) {
+            return index;
+        }
+
+        index = ProbingLinear(tabela->capacidade, index, 1);
+    }
+
+    return NAO_EXISTE;
+}
+
+// Remove uma matrícula, puxando para trás os elementos seguintes do agrupamento
+long int removeMat (HashTable *tabela, long int matricula) {
+    int index = busca(tabela, matricula);
+
+    // Matrícula não encontrada
+    if (index == NAO_EXISTE) {
+        return NAO_EXISTE;
+    }
+
+    unsigned int atual = index;
+    unsigned int prox = ProbingLinear(tabela->capacidade, atual, 1);
+
+    // Backward-shift: enquanto o próximo elemento estiver fora da posição ideal, ele volta uma posição
+    while (tabela->matriculas[prox] != -1 && tabela->distancias[prox] > 0) {
+        tabela->matriculas[atual] = tabela->matriculas[prox];
+        tabela->distancias[atual] = tabela->distancias[prox] - 1;
+        atual = prox;
+        prox = ProbingLinear(tabela->capacidade, atual, 1);
+    }
+
+    tabela->matriculas[atual] = -1;
+    tabela->distancias[atual] = 0;
+    tabela->qtdMat--;
+
+    return matricula;
+}
+
+// Distância máxima e média dos elementos até a posição ideal
+void estatisticas (HashTable *tabela, int *maxDist, double *mediaDist) {
+    long int soma = 0;
+    *maxDist = 0;
+
+    for (int i = 0; i < tabela->capacidade; i++) {
+        if (tabela->matriculas[i] != -1) {
+            soma += tabela->distancias[i];
+            if (tabela->distancias[i] > *maxDist) {
+                *maxDist = tabela->distancias[i];
+            }
+        }
+    }
+
+    *mediaDist = tabela->qtdMat ? (double)soma / tabela->qtdMat : 0;
+}
+
+// Distâncias que o probing linear comum teria com as mesmas matrículas, na mesma ordem de inserção e com a mesma capacidade
+void estatisticasLinear (HashTable *tabela, long int chaves[], int qtd, int *maxDist, double *mediaDist) {
+    long int *slots = (long int *)malloc(sizeof(long int) * tabela->capacidade);
+
+    // Verifica a alocação de memória
+    if (slots == NULL) {
+        printf("Não foi possível alocar memória para a comparação.\n");
+        return;
+    }
+
+    for (int i = 0; i < tabela->capacidade; i++) {
+        slots[i] = -1;
+    }
+
+    long int soma = 0;
+    *maxDist = 0;
+
+    for (int i = 0; i < qtd; i++) {
+        unsigned int index = hash(tabela->capacidade, chaves[i]);
+        int dist = 0;
+        while (slots[index] != -1) {
+            index = ProbingLinear(tabela->capacidade, index, 1);
+            dist++;
+        }
+        slots[index] = chaves[i];
+
+        soma += dist;
+        if (dist > *maxDist) {
+            *maxDist = dist;
+        }
+    }
+
+    *mediaDist = qtd ? (double)soma / qtd : 0;
+    free(slots);
+}
+
+// Função para imprimir as matrículas
+void imprime (HashTable *tabela) {
+    float txOcup = (float)tabela->qtdMat / tabela->capacidade;
+    printf("qtdMat = %d | Capacidade = %d | txOcup = %.2f\n", tabela->qtdMat, tabela->capacidade, txOcup);
+    for (int i = 0; i < tabela->capacidade; i++) {
+        if (tabela->matriculas[i] != -1) {
+            printf("Índice %d: %ld (distância %d)\n", i, tabela->matriculas[i], tabela->distancias[i]);
+        }
+    }
+}
+
+// Libera a memória da tabela
+void liberaHash (HashTable *tabela) {
+    free(tabela->matriculas);
+    free(tabela->distancias);
+    free(tabela);
+}
+
+int main () {
+
+    // Inicializa a hash table
+    HashTable *tabela = init_hash(tamTab);
+
+    long int retorno;
+
+    // Inserindo números de matrícula
+    printf("Inserção: \n");
+    long int matriculas[] = {12345678901, 12345678901, 12335678901, 23456789012, 34567890123, 45678901234, 12345678905, 12345678906};
+    int qtd = sizeof(matriculas) / sizeof(matriculas[0]);
+
+    for (int i = 0; i < qtd; i++) {
+        retorno = insere(tabela, matriculas[i]);
+
+        if (retorno == EXISTE) {
+            printf("Matrícula %ld já cadastrada.\n", matriculas[i]);
+        }
+        else if (retorno == TABELA_CHEIA) {
+            printf("Tabela cheia. Matrícula %ld não cadastrada.\n", matriculas[i]);
+        }
+    }
+
+    imprime(tabela);
+    printf("\n");
+
+    // Removendo matrícula
+    printf("Remoção: \n");
+    long int matricula = 23456789012;
+    retorno = removeMat(tabela, matricula);
+    if (retorno != NAO_EXISTE) {
+        printf("Matrícula %ld removida.\n", retorno);
+        imprime(tabela);
+    }
+    else {
+        printf("Matrícula %ld não encontrada.\n", matricula);
+    }
+    printf("\n");
+    liberaHash(tabela);
+
+    // Ocupação alta: matrículas aleatórias até 94% de uma tabela de 2^20 posições
+    int capacidade = 1 << 20;
+    int total = (int)(capacidade * 0.94);
+    tabela = init_hash(capacidade);
+    long int *chaves = (long int *)malloc(sizeof(long int) * total);
+
+    // Verifica a alocação de memória
+    if (tabela == NULL || chaves == NULL) {
+        printf("Não foi possível alocar memória.\n");
+        return 1;
+    }
+
+    srand(29);
+    for (int i = 0; i < total; i++) {
+        // Sorteia de novo se a matrícula já existir
+        do {
+            chaves[i] = 10000000000L + (((long int)rand() << 20) ^ rand()) % 90000000000L;
+        } while (insere(tabela, chaves[i]) == EXISTE);
+    }
+
+    int maxRH, maxLinear;
+    double mediaRH, mediaLinear;
+    estatisticas(tabela, &maxRH, &mediaRH);
+    estatisticasLinear(tabela, chaves, total, &maxLinear, &mediaLinear);
+    printf("Ocupação de %.2f:\n", (float)tabela->qtdMat / tabela->capacidade);
+    printf("Probing linear: distância máxima = %4d | média = %.2f\n", maxLinear, mediaLinear);
+    printf("Robin Hood:     distância máxima = %4d | média = %.2f\n", maxRH, mediaRH);
+
+    // Remove metade e confere que todas as restantes continuam alcançáveis
+    for (int i = 0; i < total; i += 2) {
+        removeMat(tabela, chaves[i]);
+    }
+    int erros = 0;
+    for (int i = 0; i < total; i++) {
+        int achou = busca(tabela, chaves[i]) != NAO_EXISTE;
+        if (achou != (i % 2 == 1)) {
+            erros++;
+        }
+    }
+    printf("Após remover metade: %d matrículas inalcançáveis ou sobrando.\n", erros);
+
+    // Libera a memória
+    liberaHash(tabela);
+    free(chaves);
+
+    return 0;
+}
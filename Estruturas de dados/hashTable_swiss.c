@@ -0,0 +1,431 @@
+// ## Hash Table no Estilo Swiss Table (Sondagem em Grupos de 16 com SIMD) ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Constantes
+#define tamGrupo 16 // Posições examinadas por vez (uma instrução SSE2)
+#define capMinima 16 // Capacidade inicial (um grupo)
+#define ocupMax 0.875 // Taxa de ocupação máxima (ocupadas + apagadas)
+#define VAZIO ((signed char)-128) // 0x80: posição nunca usada
+#define APAGADO ((signed char)-2) // 0xFE: posição removida (tombstone)
+
+/*
+Obs.: no hashTable.c, a busca compara cada long int da tabela com -1 e com a matrícula, uma posição por vez. Aqui a tabela tem dois vetores:
+- controle: um byte por posição. Vale VAZIO, APAGADO ou, se ocupada, os 7 bits mais baixos do hash da matrícula (h2, um valor de 0 a 127);
+- matriculas: o vetor de long int, consultado só quando o byte de controle coincide.
+
+Os bits altos do hash (h1) escolhem um grupo de 16 posições. A busca carrega os 16 bytes de controle do grupo em um registrador e, com uma comparação SSE2 e um movemask, obtém em uma máscara de 16 bits as posições cujo h2 é igual ao da matrícula. Só essas posições (em média 16/128 falsos positivos) são comparadas no vetor de matrículas. Se o grupo tem alguma posição VAZIO e a matrícula não apareceu, ela não existe: quase toda busca termina com uma única carga de 16 bytes de controle.
+
+Os grupos são sondados de forma quadrática (1, 2, 3... grupos de salto), o que percorre todos os grupos de uma tabela com quantidade de grupos potência de 2.
+
+Na remoção, se o grupo ainda tem alguma posição VAZIO, a posição removida pode voltar a ser VAZIO (nenhuma busca passou por esse grupo sem parar). Caso contrário ela vira APAGADO, para não interromper as buscas que continuam para os grupos seguintes. As posições APAGADO contam na ocupação e são eliminadas na próxima reconstrução da tabela.
+
+Sem SSE2, as mesmas máscaras são calculadas byte a byte.
+*/
+
+// Tipos enumerados
+typedef enum status {
+    SUCESSO = 0,
+    EXISTE = -1,
+    NAO_EXISTE = -2,
+    TABELA_CHEIA = -3
+} status;
+
+// Estrutura da Hash
+typedef struct HashSwiss {
+    signed char *controle; // Um byte por posição: VAZIO, APAGADO ou h2
+    long int *matriculas; // Array para armazenar os números de matrícula
+    int qtdMat; // Quantidade de matrículas cadastradas
+    int qtdApagados; // Quantidade de posições APAGADO
+    int capacidade; // Quantidade de posições (múltiplo de tamGrupo, potência de 2)
+} HashSwiss;
+
+// Cabeçalho
+HashSwiss *init_hash (int capacidade);
+uint64_t hash (long int matricula);
+int insere (HashSwiss *tabela, long int matricula);
+int redimensiona (HashSwiss *tabela, int capacidade);
+int busca (HashSwiss *tabela, long int matricula);
+long int removeMat (HashSwiss *tabela, long int matricula);
+void liberaHash (HashSwiss *tabela);
+
+// Inicializa a tabela com "capacidade" posições (arredondada para potência de 2, mínimo um grupo)
+HashSwiss *init_hash (int capacidade) {
+    int cap = capMinima;
+    while (cap < capacidade) {
+        cap *= 2;
+    }
+
+    // Aloca memória para a tabela
+    HashSwiss *tabela = (HashSwiss *)malloc(sizeof(HashSwiss));
+
+    // Verifica a alocação de memória
+    if (tabela == NULL) {
+        printf("Não foi possível alocar memória para a tabela.\n");
+        return NULL;
+    }
+
+    // Controle alinhado a 16 bytes: cada grupo é lido com uma carga alinhada
+    tabela->controle = (signed char *)aligned_alloc(tamGrupo, cap);
+    tabela->matriculas = (long int *)malloc(sizeof(long int) * cap);
+
+    // Verifica a alocação de memória
+    if (tabela->controle == NULL || tabela->matriculas == NULL) {
+        printf("Não foi possível alocar memória para as matrículas.\n");
+        free(tabela->controle);
+        free(tabela->matriculas);
+        free(tabela);
+        return NULL;
+    }
+
+    memset(tabela->controle, VAZIO, cap);
+    tabela->capacidade = cap;
+    tabela->qtdMat = 0;
+    tabela->qtdApagados = 0;
+
+    return tabela;
+}
+
+// Função hash: espalha os bits da matrícula (multiplicação de Fibonacci seguida de xor-shift)
+uint64_t hash (long int matricula) {
+    uint64_t h = (uint64_t)matricula * 11400714819323198485ull;
+    return h ^ (h >> 32);
+}
+
+// Máscara (bit i = posição i do grupo) dos bytes de controle iguais a "valor"
+static inline unsigned int comparaGrupo (const signed char *grupo, signed char valor) {
+#ifdef __SSE2__
+    __m128i ctrl = _mm_load_si128((const __m128i *)grupo);
+    return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(valor)));
+#else
+    unsigned int mascara = 0;
+    for (int i = 0; i < tamGrupo; i++) {
+        mascara |= (unsigned int)(grupo[i] == valor) << i;
+    }
+    return mascara;
+#endif
+}
+
+// Máscara das posições livres (VAZIO ou APAGADO: os dois têm o bit mais alto ligado)
+static inline unsigned int livresGrupo (const signed char *grupo) {
+#ifdef __SSE2__
+    return (unsigned int)_mm_movemask_epi8(_mm_load_si128((const __m128i *)grupo));
+#else
+    unsigned int mascara = 0;
+    for (int i = 0; i < tamGrupo; i++) {
+        mascara |= (unsigned int)(grupo[i] < 0) << i;
+    }
+    return mascara;
+#endif
+}
+
+// Função para buscar uma matrícula. Retorna a posição ou NAO_EXISTE
+int busca (HashSwiss *tabela, long int matricula) {
+    uint64_t h = hash(matricula);
+    signed char h2 = (signed char)(h & 0x7F);
+    unsigned int mascaraGrupos = tabela->capacidade / tamGrupo - 1;
+    unsigned int g = (unsigned int)(h >> 7) & mascaraGrupos;
+
+    // O grupo de matrículas (128 bytes) é pedido junto com o controle: as duas faltas de cache se sobrepõem
+    __builtin_prefetch(tabela->matriculas + (size_t)g * tamGrupo);
+    __builtin_prefetch(tabela->matriculas + (size_t)g * tamGrupo + tamGrupo / 2);
+
+    for (unsigned int salto = 1; salto <= mascaraGrupos + 1; salto++) {
+        const signed char *grupo = tabela->controle + (size_t)g * tamGrupo;
+
+        // Candidatas: posições com o mesmo h2
+        unsigned int candidatas = comparaGrupo(grupo, h2);
+        while (candidatas) {
+            int pos = g * tamGrupo + __builtin_ctz(candidatas);
+            if (tabela->matriculas[pos] == matricula) {
+                return pos;
+            }
+            candidatas &= candidatas - 1;
+        }
+
+        // Grupo com posição VAZIO: a sondagem da matrícula pararia aqui
+        if (comparaGrupo(grupo, VAZIO)) {
+            break;
+        }
+
+        // Sondagem quadrática entre grupos
+        g = (g + salto) & mascaraGrupos;
+    }
+
+    return NAO_EXISTE;
+}
+
+// Coloca a matrícula na primeira posição livre da sondagem (sem verificar duplicidade nem ocupação)
+void posiciona (HashSwiss *tabela, long int matricula) {
+    uint64_t h = hash(matricula);
+    unsigned int mascaraGrupos = tabela->capacidade / tamGrupo - 1;
+    unsigned int g = (unsigned int)(h >> 7) & mascaraGrupos;
+
+    for (unsigned int salto = 1; ; salto++) {
+        unsigned int livres = livresGrupo(tabela->controle + (size_t)g * tamGrupo);
+        if (livres) {
+            int pos = g * tamGrupo + __builtin_ctz(livres);
+            if (tabela->controle[pos] == APAGADO) {
+                tabela->qtdApagados--;
+            }
+            tabela->controle[pos] = (signed char)(h & 0x7F);
+            tabela->matriculas[pos] = matricula;
+            tabela->qtdMat++;
+            return;
+        }
+        g = (g + salto) & mascaraGrupos;
+    }
+}
+
+// Função para inserir uma matrícula na hash table
+int insere (HashSwiss *tabela, long int matricula) {
+    // Matrícula já cadastrada
+    if (busca(tabela, matricula) != NAO_EXISTE) {
+        return EXISTE;
+    }
+
+    // Verifica a taxa de ocupação (as posições APAGADO também alongam as sondagens)
+    float txOcup = (float)(tabela->qtdMat + tabela->qtdApagados + 1) / tabela->capacidade;
+    if (txOcup > ocupMax) {
+        // Muitas posições APAGADO: reconstrói no mesmo tamanho. Senão, dobra
+        int capacidade = (tabela->qtdMat + 1 > tabela->capacidade * ocupMax / 2) ? tabela->capacidade * 2 : tabela->capacidade;
+        if (!redimensiona(tabela, capacidade)) {
+            return TABELA_CHEIA;
+        }
+    }
+
+    posiciona(tabela, matricula);
+
+    return SUCESSO;
+}
+
+// Reconstrói a tabela com a capacidade indicada, descartando as posições APAGADO. Retorna 0 em caso de falha
+int redimensiona (HashSwiss *tabela, int capacidade) {
+    HashSwiss *nova = init_hash(capacidade);
+
+    if (nova == NULL) {
+        return 0;
+    }
+
+    // Re-hash dos elementos existentes
+    for (int i = 0; i < tabela->capacidade; i++) {
+        if (tabela->controle[i] >= 0) {
+            posiciona(nova, tabela->matriculas[i]);
+        }
+    }
+
+    // A tabela passa a usar os vetores novos
+    free(tabela->controle);
+    free(tabela->matriculas);
+    *tabela = *nova;
+    free(nova);
+
+    return 1;
+}
+
+// Função para remover uma matrícula
+long int removeMat (HashSwiss *tabela, long int matricula) {
+    int pos = busca(tabela, matricula);
+
+    // Matrícula não encontrada
+    if (pos == NAO_EXISTE) {
+        return NAO_EXISTE;
+    }
+
+    // Se o grupo tem posição VAZIO, nenhuma sondagem passou por ele: a posição pode voltar a ser VAZIO
+    const signed char *grupo = tabela->controle + (pos & ~(tamGrupo - 1));
+    if (comparaGrupo(grupo, VAZIO)) {
+        tabela->controle[pos] = VAZIO;
+    }
+    else {
+        tabela->controle[pos] = APAGADO;
+        tabela->qtdApagados++;
+    }
+    tabela->qtdMat--;
+
+    return matricula;
+}
+
+// Função para imprimir as matrículas
+void imprime (HashSwiss *tabela) {
+    float txOcup = (float)tabela->qtdMat / tabela->capacidade;
+    printf("qtdMat = %d | Capacidade = %d | txOcup = %.2f\n", tabela->qtdMat, tabela->capacidade, txOcup);
+    for (int i = 0; i < tabela->capacidade; i++) {
+        if (tabela->controle[i] >= 0) {
+            printf("Índice %d: %ld (h2 = %d)\n", i, tabela->matriculas[i], tabela->controle[i]);
+        }
+    }
+}
+
+// Libera a memória da tabela
+void liberaHash (HashSwiss *tabela) {
+    free(tabela->controle);
+    free(tabela->matriculas);
+    free(tabela);
+}
+
+// Busca do hashTable.c (probing linear com módulo), para comparação em vetor de mesma capacidade
+int buscaLinear (long int *matriculas, int capacidade, long int matricula) {
+    unsigned int index = matricula % capacidade;
+
+    for (int i = 0; i < capacidade; i++) {
+        if (matriculas[index] == -1) {
+            break;
+        }
+        if (matriculas[index] == matricula) {
+            return index;
+        }
+        index = (index + 1) % capacidade;
+    }
+
+    return NAO_EXISTE;
+}
+
+// Tempo em segundos
+double agora () {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Compara a busca do hashTable.c com a busca swiss na mesma ocupação (0.80) e capacidade. Retorna as divergências
+int comparaBuscas (int capacidade, int consultas) {
+    int total = (int)(capacidade * 0.80);
+    HashSwiss *tabela = init_hash(capacidade);
+    long int *linear = (long int *)malloc(sizeof(long int) * capacidade);
+    long int *chaves = (long int *)malloc(sizeof(long int) * total);
+    long int *ausentes = (long int *)malloc(sizeof(long int) * total);
+
+    // Verifica a alocação de memória
+    if (tabela == NULL || linear == NULL || chaves == NULL || ausentes == NULL) {
+        printf("Não foi possível alocar memória.\n");
+        return -1;
+    }
+
+    for (int i = 0; i < capacidade; i++) {
+        linear[i] = -1;
+    }
+
+    for (int i = 0; i < total; i++) {
+        // Sorteia de novo se a matrícula já existir
+        do {
+            chaves[i] = 10000000000L + (((long int)rand() << 20) ^ rand()) % 90000000000L;
+        } while (insere(tabela, chaves[i]) == EXISTE);
+
+        unsigned int index = chaves[i] % capacidade;
+        while (linear[index] != -1) {
+            index = (index + 1) % capacidade;
+        }
+        linear[index] = chaves[i];
+    }
+
+    // Ausentes: fora do intervalo sorteado, logo distintas entre si e das cadastradas
+    for (int i = 0; i < total; i++) {
+        ausentes[i] = chaves[i] + 90000000000L;
+    }
+    printf("Ocupação de %.2f, capacidade %d (%.1f MB), %d consultas:\n", (float)tabela->qtdMat / tabela->capacidade, tabela->capacidade,
+           capacidade * (sizeof(long int) + 1) / 1048576.0, consultas);
+
+    // Consultas em ordem aleatória (existentes e ausentes)
+    for (int tipo = 0; tipo < 2; tipo++) {
+        long int *fonte = (tipo == 0) ? chaves : ausentes;
+        long int achados[2] = {0, 0};
+        double tempo[2];
+
+        double inicio = agora();
+        for (int i = 0; i < consultas; i++) {
+            achados[0] += buscaLinear(linear, capacidade, fonte[(unsigned int)(i * 2654435761u) % total]) != NAO_EXISTE;
+        }
+        tempo[0] = agora() - inicio;
+
+        inicio = agora();
+        for (int i = 0; i < consultas; i++) {
+            achados[1] += busca(tabela, fonte[(unsigned int)(i * 2654435761u) % total]) != NAO_EXISTE;
+        }
+        tempo[1] = agora() - inicio;
+
+        printf("%s: busca linear %6.1f ns (%ld achadas) | busca swiss %6.1f ns (%ld achadas) | %.1fx\n", tipo == 0 ? "Existentes" : "Ausentes  ",
+               tempo[0] * 1e9 / consultas, achados[0], tempo[1] * 1e9 / consultas, achados[1], tempo[0] / tempo[1]);
+    }
+
+    // Remove metade, insere metade das ausentes e confere que todas continuam alcançáveis
+    for (int i = 0; i < total; i += 2) {
+        removeMat(tabela, chaves[i]);
+    }
+    for (int i = 0; i < total / 2; i++) {
+        insere(tabela, ausentes[i]);
+    }
+    int erros = 0;
+    for (int i = 0; i < total; i++) {
+        if ((busca(tabela, chaves[i]) != NAO_EXISTE) != (i % 2 == 1)) {
+            erros++;
+        }
+        if ((busca(tabela, ausentes[i]) != NAO_EXISTE) != (i < total / 2)) {
+            erros++;
+        }
+    }
+    printf("Após remover e reinserir: %d divergências (apagadas = %d).\n\n", erros, tabela->qtdApagados);
+
+    // Libera a memória
+    liberaHash(tabela);
+    free(linear);
+    free(chaves);
+    free(ausentes);
+
+    return erros;
+}
+
+int main () {
+
+    // Inicializa a hash table
+    HashSwiss *tabela = init_hash(capMinima);
+
+    long int retorno;
+
+    // Inserindo números de matrícula
+    printf("Inserção: \n");
+    long int matriculas[] = {12345678901, 12345678901, 12335678901, 23456789012, 34567890123, 45678901234, 12345678905, 12345678906};
+    int qtd = sizeof(matriculas) / sizeof(matriculas[0]);
+
+    for (int i = 0; i < qtd; i++) {
+        retorno = insere(tabela, matriculas[i]);
+
+        if (retorno == EXISTE) {
+            printf("Matrícula %ld já cadastrada.\n", matriculas[i]);
+        }
+        else if (retorno == TABELA_CHEIA) {
+            printf("Tabela cheia. Matrícula %ld não cadastrada.\n", matriculas[i]);
+        }
+    }
+
+    imprime(tabela);
+    printf("\n");
+
+    // Removendo matrícula
+    printf("Remoção: \n");
+    long int matricula = 23456789012;
+    retorno = removeMat(tabela, matricula);
+    if (retorno != NAO_EXISTE) {
+        printf("Matrícula %ld removida.\n", retorno);
+        imprime(tabela);
+    }
+    else {
+        printf("Matrícula %ld não encontrada.\n", matricula);
+    }
+    printf("\n");
+    liberaHash(tabela);
+
+    // Tabela que cabe no cache e tabela muito maior que o cache
+    srand(38);
+    comparaBuscas(1 << 15, 10000000);
+    comparaBuscas(1 << 22, 10000000);
+
+    return 0;
+}
@@ -0,0 +1,739 @@
+// ## Mediana e Quantis Online com Dois Heaps ##
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+Obs.: a estrutura divide os elementos em duas metades:
+- inferior: Max Heap (mesma lógica do Heap.c) com os menores elementos;
+- superior: Min Heap com os maiores elementos.
+Todo elemento da inferior é menor ou igual a todo elemento da superior, e a inferior guarda exatamente floor(q * (n - 1)) + 1 elementos. Assim, a raiz da inferior é o quantil q (q = 0.5 dá a mediana) e cada atualização custa O(log n), sem reordenar o vetor a cada consulta.
+
+A remoção por valor é preguiçosa: o valor fica marcado como pendente e só sai fisicamente do heap quando chega à raiz. Os tamanhos de cada metade contam apenas os elementos vivos.
+*/
+
+// Heap com índice 0 desprezado e crescimento dinâmico
+typedef struct Heap {
+    int *v; // Elementos (a raiz ocupa o índice 1)
+    int n; // Quantidade de elementos (vivos + pendentes)
+    int capacidade; // Espaços alocados, sem contar o índice 0
+} Heap;
+
+// Entrada do mapa valor -> contagens
+typedef struct Entrada {
+    int valor;
+    int vivos; // Cópias do valor presentes na estrutura
+    int pendentes; // Cópias removidas que ainda estão fisicamente nos heaps
+    int ocupada; // 1 se a posição do mapa está em uso
+} Entrada;
+
+// Mapa com endereçamento aberto e probing linear
+typedef struct Mapa {
+    Entrada *entradas;
+    int qtd;
+    unsigned int mascara; // Capacidade - 1 (capacidade potência de 2)
+} Mapa;
+
+// Estrutura do quantil online
+typedef struct Mediana {
+    Heap inferior; // Max Heap
+    Heap superior; // Min Heap
+    int tamInf; // Elementos vivos na inferior
+    int tamSup; // Elementos vivos na superior
+    double q; // Quantil monitorado (0.5 = mediana)
+    Mapa mapa; // Contagem de vivos e pendentes por valor
+    int *janela; // Buffer circular da janela deslizante (NULL = sem janela)
+    int tamJanela; // Tamanho máximo da janela
+    int iniJanela; // Índice do elemento mais antigo da janela
+    int qtdJanela; // Quantidade de elementos na janela
+} Mediana;
+
+// Estimador P² (Jain e Chlamtac): quantil aproximado com memória O(1)
+typedef struct P2 {
+    double q; // Quantil estimado (ex.: 0.99)
+    double altura[5]; // Alturas dos marcadores
+    double pos[5]; // Posições reais dos marcadores
+    double desejada[5]; // Posições desejadas dos marcadores
+    double incremento[5]; // Incremento das posições desejadas a cada observação
+    long int n; // Quantidade de observações
+} P2;
+
+// Cabeçalho
+void troca (int *x, int *y);
+int pai (int i);
+int filhoEsq (int i);
+int filhoDir (int i);
+int HeapInsere (Heap *h, int num, int maxHeap);
+void HeapSobe (int heap[], int i);
+void Heapfy (int heap[], int i, int n);
+void HeapSobeMin (int heap[], int i);
+void HeapfyMin (int heap[], int i, int n);
+int HeapRemove (Heap *h, int maxHeap);
+Mediana *init_mediana (double q, int tamJanela);
+int MedianaInsere (Mediana *m, int num);
+int MedianaRemove (Mediana *m, int num);
+int MedianaQuantil (Mediana *m);
+double MedianaValor (Mediana *m);
+void MedianaLibera (Mediana *m);
+void init_p2 (P2 *p, double q);
+void P2Insere (P2 *p, double x);
+double P2Valor (const P2 *p);
+
+void troca (int *x, int *y) {
+    int temp = *x;
+    *x = *y;
+    *y = temp;
+}
+
+// Calcula a posição do pai de um elemento na posição i
+int pai (int i) {
+    return i / 2;
+}
+
+// Calcula o filho esquerdo de um elemento na posição i
+int filhoEsq (int i) {
+    return 2 * i;
+}
+
+// Calcula o filho direito de um elemento na posição i
+int filhoDir (int i) {
+    return 2 * i + 1;
+}
+
+// Mantém a propriedade do Max Heap após a inserção
+void HeapSobe (int heap[], int i) {
+    int j = pai(i);
+
+    // Pai é menor que o filho
+    if (i > 1 && heap[j] < heap[i]) {
+        troca(&heap[j], &heap[i]);
+        HeapSobe(heap, j);
+    }
+}
+
+// Mantém a propriedade do Max Heap após a exclusão
+void Heapfy (int heap[], int i, int n) {
+    int esq = filhoEsq(i);
+    int dir = filhoDir(i);
+    int maior = i;
+
+    if (esq <= n && heap[esq] > heap[i]) {
+        maior = esq;
+    }
+
+    if (dir <= n && heap[dir] > heap[maior]) {
+        maior = dir;
+    }
+
+    if (maior != i) {
+        troca(&heap[maior], &heap[i]);
+        Heapfy(heap, maior, n);
+    }
+}
+
+// Mantém a propriedade do Min Heap após a inserção
+void HeapSobeMin (int heap[], int i) {
+    int j = pai(i);
+
+    // Pai é maior que o filho
+    if (i > 1 && heap[j] > heap[i]) {
+        troca(&heap[j], &heap[i]);
+        HeapSobeMin(heap, j);
+    }
+}
+
+// Mantém a propriedade do Min Heap após a exclusão
+void HeapfyMin (int heap[], int i, int n) {
+    int esq = filhoEsq(i);
+    int dir = filhoDir(i);
+    int menor = i;
+
+    if (esq <= n && heap[esq] < heap[i]) {
+        menor = esq;
+    }
+
+    if (dir <= n && heap[dir] < heap[menor]) {
+        menor = dir;
+    }
+
+    if (menor != i) {
+        troca(&heap[menor], &heap[i]);
+        HeapfyMin(heap, menor, n);
+    }
+}
+
+// Insere no heap, dobrando a capacidade quando necessário. Retorna 0 em caso de falha
+int HeapInsere (Heap *h, int num, int maxHeap) {
+    // Heap cheio: dobra a capacidade
+    if (h->n >= h->capacidade) {
+        int capacidadeNova = h->capacidade * 2;
+        int *novo = (int *)realloc(h->v, sizeof(int) * (capacidadeNova + 1));
+
+        // Verifica a alocação de memória
+        if (novo == NULL) {
+            printf("Não foi possível realocar memória para o heap.\n");
+            return 0;
+        }
+
+        h->v = novo;
+        h->capacidade = capacidadeNova;
+    }
+
+    h->n++;
+    h->v[h->n] = num;
+
+    if (maxHeap) {
+        HeapSobe(h->v, h->n);
+    }
+    else {
+        HeapSobeMin(h->v, h->n);
+    }
+
+    return 1;
+}
+
+// Remove e retorna a raiz do heap
+int HeapRemove (Heap *h, int maxHeap) {
+    int raiz = h->v[1];
+
+    troca(&h->v[1], &h->v[h->n]);
+    h->n--;
+
+    if (maxHeap) {
+        Heapfy(h->v, 1, h->n);
+    }
+    else {
+        HeapfyMin(h->v, 1, h->n);
+    }
+
+    return raiz;
+}
+
+// ##################################################### //
+// MAPA VALOR -> CONTAGENS
+
+// Função hash (Fibonacci) para o mapa
+unsigned int hashValor (int valor, unsigned int mascara) {
+    return (unsigned int)(((unsigned int)valor * 2654435769u) >> 7) & mascara;
+}
+
+// Retorna a entrada do valor ou NULL
+Entrada *mapaBusca (Mapa *mapa, int valor) {
+    unsigned int i = hashValor(valor, mapa->mascara);
+
+    while (mapa->entradas[i].ocupada) {
+        if (mapa->entradas[i].valor == valor) {
+            return &mapa->entradas[i];
+        }
+        i = (i + 1) & mapa->mascara;
+    }
+
+    return NULL;
+}
+
+// Dobra a capacidade do mapa e redistribui as entradas. Retorna 0 em caso de falha
+int mapaRedimensiona (Mapa *mapa) {
+    unsigned int capacidadeAntiga = mapa->mascara + 1;
+    unsigned int capacidadeNova = capacidadeAntiga * 2;
+    Entrada *antigas = mapa->entradas;
+
+    mapa->entradas = (Entrada *)calloc(capacidadeNova, sizeof(Entrada));
+
+    // Verifica a alocação de memória
+    if (mapa->entradas == NULL) {
+        printf("Não foi possível realocar memória para o mapa.\n");
+        mapa->entradas = antigas;
+        return 0;
+    }
+
+    mapa->mascara = capacidadeNova - 1;
+
+    for (unsigned int j = 0; j < capacidadeAntiga; j++) {
+        if (antigas[j].ocupada) {
+            unsigned int i = hashValor(antigas[j].valor, mapa->mascara);
+            while (mapa->entradas[i].ocupada) {
+                i = (i + 1) & mapa->mascara;
+            }
+            mapa->entradas[i] = antigas[j];
+        }
+    }
+
+    free(antigas);
+    return 1;
+}
+
+// Retorna a entrada do valor, criando-a se necessário (NULL em caso de falha)
+Entrada *mapaObtem (Mapa *mapa, int valor) {
+    Entrada *e = mapaBusca(mapa, valor);
+
+    if (e != NULL) {
+        return e;
+    }
+
+    // Ocupação máxima de 50%
+    if (2 * (unsigned int)(mapa->qtd + 1) > mapa->mascara + 1 && !mapaRedimensiona(mapa)) {
+        return NULL;
+    }
+
+    unsigned int i = hashValor(valor, mapa->mascara);
+    while (mapa->entradas[i].ocupada) {
+        i = (i + 1) & mapa->mascara;
+    }
+
+    mapa->entradas[i].valor = valor;
+    mapa->entradas[i].vivos = 0;
+    mapa->entradas[i].pendentes = 0;
+    mapa->entradas[i].ocupada = 1;
+    mapa->qtd++;
+
+    return &mapa->entradas[i];
+}
+
+// Remove a entrada quando não há mais cópias do valor (backward-shift)
+void mapaLimpa (Mapa *mapa, Entrada *e) {
+    if (e->vivos > 0 || e->pendentes > 0) {
+        return;
+    }
+
+    unsigned int i = (unsigned int)(e - mapa->entradas);
+    unsigned int j = i;
+
+    while (1) {
+        j = (j + 1) & mapa->mascara;
+
+        if (!mapa->entradas[j].ocupada) {
+            break;
+        }
+
+        unsigned int ideal = hashValor(mapa->entradas[j].valor, mapa->mascara);
+
+        // O elemento em j pode ir para o buraco i se o seu índice ideal não estiver em (i, j]
+        if (((j - ideal) & mapa->mascara) >= ((j - i) & mapa->mascara)) {
+            mapa->entradas[i] = mapa->entradas[j];
+            i = j;
+        }
+    }
+
+    mapa->entradas[i].ocupada = 0;
+    mapa->qtd--;
+}
+
+// ##################################################### //
+// QUANTIL ONLINE
+
+// Inicializa a estrutura para o quantil q. tamJanela = 0 desativa a janela deslizante
+Mediana *init_mediana (double q, int tamJanela) {
+    Mediana *m = (Mediana *)calloc(1, sizeof(Mediana));
+
+    // Verifica a alocação de memória
+    if (m == NULL) {
+        printf("Não foi possível alocar memória para a mediana.\n");
+        return NULL;
+    }
+
+    m->q = q;
+    m->inferior.capacidade = 16;
+    m->superior.capacidade = 16;
+    m->inferior.v = (int *)malloc(sizeof(int) * (m->inferior.capacidade + 1));
+    m->superior.v = (int *)malloc(sizeof(int) * (m->superior.capacidade + 1));
+    m->mapa.mascara = 15;
+    m->mapa.entradas = (Entrada *)calloc(m->mapa.mascara + 1, sizeof(Entrada));
+    m->tamJanela = tamJanela;
+
+    if (tamJanela > 0) {
+        m->janela = (int *)malloc(sizeof(int) * tamJanela);
+    }
+
+    // Verifica a alocação de memória
+    if (m->inferior.v == NULL || m->superior.v == NULL || m->mapa.entradas == NULL || (tamJanela > 0 && m->janela == NULL)) {
+        printf("Não foi possível alocar memória para os heaps.\n");
+        MedianaLibera(m);
+        return NULL;
+    }
+
+    return m;
+}
+
+// Descarta da raiz os elementos com remoção pendente
+void limpaRaiz (Mediana *m, Heap *h, int maxHeap) {
+    while (h->n > 0) {
+        Entrada *e = mapaBusca(&m->mapa, h->v[1]);
+
+        if (e->pendentes == 0) {
+            break;
+        }
+
+        e->pendentes--;
+        HeapRemove(h, maxHeap);
+        mapaLimpa(&m->mapa, e);
+    }
+}
+
+// Tamanho que a metade inferior deve ter para n elementos vivos
+int alvoInferior (const Mediana *m, int n) {
+    if (n == 0) {
+        return 0;
+    }
+    return (int)(m->q * (n - 1)) + 1; // floor: o produto não é negativo
+}
+
+// Move elementos entre as metades até a inferior ter o tamanho alvo
+void balanceia (Mediana *m) {
+    int alvo = alvoInferior(m, m->tamInf + m->tamSup);
+
+    limpaRaiz(m, &m->inferior, 1);
+    limpaRaiz(m, &m->superior, 0);
+
+    while (m->tamInf > alvo) {
+        HeapInsere(&m->superior, HeapRemove(&m->inferior, 1), 0);
+        m->tamInf--;
+        m->tamSup++;
+        limpaRaiz(m, &m->inferior, 1);
+    }
+
+    while (m->tamInf < alvo) {
+        HeapInsere(&m->inferior, HeapRemove(&m->superior, 0), 1);
+        m->tamSup--;
+        m->tamInf++;
+        limpaRaiz(m, &m->superior, 0);
+    }
+}
+
+// Insere um valor sem tratar a janela
+int insereValor (Mediana *m, int num) {
+    Entrada *e = mapaObtem(&m->mapa, num);
+
+    if (e == NULL) {
+        return 0;
+    }
+
+    // Valores até a raiz da inferior vão para a inferior
+    if (m->tamInf == 0 || num <= m->inferior.v[1]) {
+        if (!HeapInsere(&m->inferior, num, 1)) {
+            return 0;
+        }
+        m->tamInf++;
+    }
+    else {
+        if (!HeapInsere(&m->superior, num, 0)) {
+            return 0;
+        }
+        m->tamSup++;
+    }
+
+    e = mapaBusca(&m->mapa, num); // A entrada pode ter mudado de lugar
+    e->vivos++;
+    balanceia(m);
+
+    return 1;
+}
+
+// Remove uma cópia de um valor. Retorna 0 se o valor não está presente
+int MedianaRemove (Mediana *m, int num) {
+    Entrada *e = mapaBusca(&m->mapa, num);
+
+    if (e == NULL || e->vivos == 0) {
+        return 0;
+    }
+
+    e->vivos--;
+
+    // As raízes estão sempre vivas (balanceia limpa as duas)
+    if (num <= m->inferior.v[1]) {
+        m->tamInf--;
+        if (num == m->inferior.v[1]) {
+            HeapRemove(&m->inferior, 1);
+        }
+        else {
+            e->pendentes++;
+        }
+    }
+    else {
+        m->tamSup--;
+        if (num == m->superior.v[1]) {
+            HeapRemove(&m->superior, 0);
+        }
+        else {
+            e->pendentes++;
+        }
+    }
+
+    mapaLimpa(&m->mapa, e);
+    balanceia(m);
+
+    return 1;
+}
+
+// Insere um valor. Com janela, o valor mais antigo sai quando a janela está cheia
+int MedianaInsere (Mediana *m, int num) {
+    if (m->janela == NULL) {
+        return insereValor(m, num);
+    }
+
+    // Janela cheia: remove o mais antigo
+    if (m->qtdJanela == m->tamJanela) {
+        MedianaRemove(m, m->janela[m->iniJanela]);
+        m->iniJanela = (m->iniJanela + 1) % m->tamJanela;
+        m->qtdJanela--;
+    }
+
+    m->janela[(m->iniJanela + m->qtdJanela) % m->tamJanela] = num;
+    m->qtdJanela++;
+
+    return insereValor(m, num);
+}
+
+// Retorna o quantil q (raiz da metade inferior)
+int MedianaQuantil (Mediana *m) {
+    if (m->tamInf == 0) {
+        printf("Estrutura vazia!\n");
+        return -1;
+    }
+    return m->inferior.v[1];
+}
+
+// Retorna a mediana (média dos dois centrais quando a quantidade é par). Exige q = 0.5
+double MedianaValor (Mediana *m) {
+    if (m->tamInf == 0) {
+        printf("Estrutura vazia!\n");
+        return -1;
+    }
+
+    if (m->tamInf == m->tamSup) {
+        return ((double)m->inferior.v[1] + m->superior.v[1]) / 2.0;
+    }
+
+    return m->inferior.v[1];
+}
+
+// Libera a memória da estrutura
+void MedianaLibera (Mediana *m) {
+    free(m->inferior.v);
+    free(m->superior.v);
+    free(m->mapa.entradas);
+    free(m->janela);
+    free(m);
+}
+
+// ##################################################### //
+// QUANTIL APROXIMADO (P²)
+
+/*
+Obs.: para quantis de cauda (p99 de latência) sobre fluxos longos, guardar todos os elementos nos dois heaps é caro. O P² mantém apenas 5 marcadores (mínimo, q/2, q, (1+q)/2 e máximo) e ajusta suas alturas por interpolação parabólica a cada observação: memória O(1) e custo O(1) por atualização, com erro pequeno para distribuições contínuas.
+*/
+
+// Inicializa o estimador para o quantil q
+void init_p2 (P2 *p, double q) {
+    p->q = q;
+    p->n = 0;
+
+    for (int i = 0; i < 5; i++) {
+        p->pos[i] = i + 1;
+    }
+
+    p->desejada[0] = 1;
+    p->desejada[1] = 1 + 2 * q;
+    p->desejada[2] = 1 + 4 * q;
+    p->desejada[3] = 3 + 2 * q;
+    p->desejada[4] = 5;
+
+    p->incremento[0] = 0;
+    p->incremento[1] = q / 2;
+    p->incremento[2] = q;
+    p->incremento[3] = (1 + q) / 2;
+    p->incremento[4] = 1;
+}
+
+// Fórmula parabólica do P² para o marcador i na direção d
+double p2Parabolica (const P2 *p, int i, double d) {
+    const double *h = p->altura;
+    const double *n = p->pos;
+
+    return h[i] + d / (n[i + 1] - n[i - 1]) *
+        ((n[i] - n[i - 1] + d) * (h[i + 1] - h[i]) / (n[i + 1] - n[i]) +
+         (n[i + 1] - n[i] - d) * (h[i] - h[i - 1]) / (n[i] - n[i - 1]));
+}
+
+// Registra uma observação
+void P2Insere (P2 *p, double x) {
+    // As 5 primeiras observações formam os marcadores iniciais (ordenados)
+    if (p->n < 5) {
+        int j = (int)p->n - 1;
+        while (j >= 0 && p->altura[j] > x) {
+            p->altura[j + 1] = p->altura[j];
+            j--;
+        }
+        p->altura[j + 1] = x;
+        p->n++;
+        return;
+    }
+
+    p->n++;
+
+    // Encontra a célula k em que x cai e ajusta os extremos
+    int k;
+    if (x < p->altura[0]) {
+        p->altura[0] = x;
+        k = 0;
+    }
+    else if (x >= p->altura[4]) {
+        p->altura[4] = x;
+        k = 3;
+    }
+    else {
+        k = 0;
+        while (x >= p->altura[k + 1]) {
+            k++;
+        }
+    }
+
+    // Incrementa as posições dos marcadores acima de k
+    for (int i = k + 1; i < 5; i++) {
+        p->pos[i]++;
+    }
+    for (int i = 0; i < 5; i++) {
+        p->desejada[i] += p->incremento[i];
+    }
+
+    // Ajusta os marcadores centrais
+    for (int i = 1; i <= 3; i++) {
+        double d = p->desejada[i] - p->pos[i];
+
+        if ((d >= 1 && p->pos[i + 1] - p->pos[i] > 1) || (d <= -1 && p->pos[i - 1] - p->pos[i] < -1)) {
+            d = (d > 0) ? 1 : -1;
+            double h = p2Parabolica(p, i, d);
+
+            // Se a parábola sair do intervalo, usa interpolação linear
+            if (p->altura[i - 1] < h && h < p->altura[i + 1]) {
+                p->altura[i] = h;
+            }
+            else {
+                int j = i + (int)d;
+                p->altura[i] += d * (p->altura[j] - p->altura[i]) / (p->pos[j] - p->pos[i]);
+            }
+
+            p->pos[i] += d;
+        }
+    }
+}
+
+// Retorna a estimativa atual do quantil
+double P2Valor (const P2 *p) {
+    // Poucas observações: quantil exato das que existem
+    if (p->n < 5) {
+        if (p->n == 0) {
+            return 0;
+        }
+        return p->altura[(int)(p->q * (p->n - 1))];
+    }
+
+    return p->altura[2];
+}
+
+// ##################################################### //
+// DEMONSTRAÇÃO
+
+// Ordena um vetor com insertion sort (referência para conferência)
+void insertionSort (int V[], int n) {
+    for (int i = 1; i < n; i++) {
+        int chave = V[i];
+        int j = i - 1;
+        while (j >= 0 && V[j] > chave) {
+            V[j + 1] = V[j];
+            j--;
+        }
+        V[j + 1] = chave;
+    }
+}
+
+int main () {
+    // Mediana de um fluxo com inserções e remoções por valor
+    printf("Mediana online:\n");
+    Mediana *m = init_mediana(0.5, 0);
+    int V[] = {5, 15, 1, 3, 8, 7, 9, 10, 20, 2};
+    int n = sizeof(V) / sizeof(V[0]);
+
+    for (int i = 0; i < n; i++) {
+        MedianaInsere(m, V[i]);
+        printf("Insere %2d -> mediana = %.1f\n", V[i], MedianaValor(m));
+    }
+
+    MedianaRemove(m, 15);
+    printf("Remove 15 -> mediana = %.1f\n", MedianaValor(m));
+    MedianaRemove(m, 1);
+    printf("Remove  1 -> mediana = %.1f\n", MedianaValor(m));
+    printf("Remove 99 -> %s\n\n", MedianaRemove(m, 99) ? "removido" : "valor ausente");
+    MedianaLibera(m);
+
+    // Janela deslizante: confere com a ordenação completa a cada passo
+    int tamJanela = 101;
+    int qtd = 20000;
+    int *fluxo = (int *)malloc(sizeof(int) * qtd);
+    int *copia = (int *)malloc(sizeof(int) * tamJanela);
+
+    // Verifica a alocação de memória
+    if (fluxo == NULL || copia == NULL) {
+        printf("Não foi possível alocar memória para o fluxo.\n");
+        return 1;
+    }
+
+    srand(7);
+    for (int i = 0; i < qtd; i++) {
+        fluxo[i] = rand() % 1000; // Muitos valores repetidos
+    }
+
+    m = init_mediana(0.5, tamJanela);
+    Mediana *p90 = init_mediana(0.9, tamJanela);
+    int erros = 0;
+
+    for (int i = 0; i < qtd; i++) {
+        MedianaInsere(m, fluxo[i]);
+        MedianaInsere(p90, fluxo[i]);
+
+        if (i + 1 >= tamJanela) {
+            for (int j = 0; j < tamJanela; j++) {
+                copia[j] = fluxo[i + 1 - tamJanela + j];
+            }
+            insertionSort(copia, tamJanela);
+
+            if (MedianaValor(m) != copia[tamJanela / 2] || MedianaQuantil(p90) != copia[(int)(0.9 * (tamJanela - 1))]) {
+                erros++;
+            }
+        }
+    }
+
+    printf("Janela deslizante de %d elementos: %d divergências em %d consultas.\n\n", tamJanela, erros, qtd - tamJanela + 1);
+    MedianaLibera(m);
+    MedianaLibera(p90);
+
+    // p99 aproximado de latências (em microssegundos: a maioria entre 100 e 300, e 2% na cauda, entre 1000 e 10000)
+    int qtdLat = 200000;
+    int *latencias = (int *)realloc(fluxo, sizeof(int) * qtdLat);
+
+    // Verifica a alocação de memória
+    if (latencias == NULL) {
+        printf("Não foi possível alocar memória para as latências.\n");
+        free(fluxo);
+        free(copia);
+        return 1;
+    }
+
+    P2 p99;
+    init_p2(&p99, 0.99);
+    Mediana *exato = init_mediana(0.99, 0);
+
+    for (int i = 0; i < qtdLat; i++) {
+        latencias[i] = (rand() % 100 < 2) ? 1000 + rand() % 9000 : 100 + rand() % 200;
+        P2Insere(&p99, latencias[i]);
+        MedianaInsere(exato, latencias[i]);
+    }
+
+    printf("p99 de %d latências: aproximado (P²) = %.1f | exato (dois heaps) = %d\n", qtdLat, P2Valor(&p99), MedianaQuantil(exato));
+
+    // Libera a memória
+    MedianaLibera(exato);
+    free(latencias);
+    free(copia);
+
+    return 0;
+}
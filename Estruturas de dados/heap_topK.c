@@ -0,0 +1,597 @@
+// ## Top-K e Heavy Hitters em Fluxo com Min Heap ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#define qtdThreads 4 // Quantidade de threads da demonstração
+
+/*
+Obs.: assim como no Heap.c, o índice 0 é desprezado e a raiz ocupa o índice 1. A diferença é que aqui o heap é de mínimo: a raiz guarda o MENOR dos K maiores valores vistos até agora. Essa raiz funciona como limiar: qualquer elemento menor ou igual a ela não entra no top-K, e é descartado com uma única comparação. A memória usada é sempre O(K), independentemente do tamanho do fluxo.
+*/
+
+// Estrutura do Top-K (valores)
+typedef struct TopK {
+    int *heap; // Min Heap com os K maiores valores (índice 0 desprezado)
+    int n; // Quantidade de elementos no heap
+    int k; // Quantidade máxima de elementos (K)
+} TopK;
+
+// Contador do Space-Saving (heavy hitters)
+typedef struct Contador {
+    long int chave; // Chave monitorada
+    long int contagem; // Frequência estimada (nunca subestima)
+    long int erro; // Superestimativa máxima da contagem
+    int pos; // Posição do contador no heap
+} Contador;
+
+// Estrutura do rastreador de chaves mais frequentes (heavy hitters)
+typedef struct HeavyHitters {
+    Contador *contadores; // Contadores (posições fixas)
+    int *heap; // Min Heap de índices de contadores, pela contagem (índice 0 desprezado)
+    int n; // Quantidade de contadores em uso
+    int k; // Quantidade máxima de contadores
+    long int *chaves; // Mapa chave -> contador: chaves (endereçamento aberto)
+    int *slots; // Mapa chave -> contador: índice do contador (-1 = vazio)
+    unsigned int mascara; // Capacidade do mapa - 1 (capacidade potência de 2)
+} HeavyHitters;
+
+// Cabeçalho
+void troca (int *x, int *y);
+int pai (int i);
+int filhoEsq (int i);
+int filhoDir (int i);
+void HeapSobeMin (int heap[], int i);
+void HeapfyMin (int heap[], int i, int n);
+TopK *init_topK (int k);
+void TopKInsere (TopK *t, int num);
+void TopKInsereLote (TopK *t, const int V[], int qtd);
+void TopKMescla (TopK *destino, const TopK *origem);
+int TopKResultado (const TopK *t, int saida[]);
+void TopKLibera (TopK *t);
+HeavyHitters *init_heavy (int k);
+void HeavyInsere (HeavyHitters *h, long int chave, long int peso);
+void HeavyInsereLote (HeavyHitters *h, const long int V[], int qtd);
+void HeavyMescla (HeavyHitters *destino, const HeavyHitters *origem);
+void HeavyImprime (const HeavyHitters *h);
+void HeavyLibera (HeavyHitters *h);
+
+void troca (int *x, int *y) {
+    int temp = *x;
+    *x = *y;
+    *y = temp;
+}
+
+// Calcula a posição do pai de um elemento na posição i
+int pai (int i) {
+    return i / 2;
+}
+
+// Calcula o filho esquerdo de um elemento na posição i
+int filhoEsq (int i) {
+    return 2 * i;
+}
+
+// Calcula o filho direito de um elemento na posição i
+int filhoDir (int i) {
+    return 2 * i + 1;
+}
+
+// Mantém a propriedade do Min Heap após a inserção (espelho do HeapSobe)
+void HeapSobeMin (int heap[], int i) {
+    int j = pai(i);
+
+    // Pai é maior que o filho
+    if (i > 1 && heap[j] > heap[i]) {
+        troca(&heap[j], &heap[i]); // Sobe o filho
+        HeapSobeMin(heap, j); // Chamada recursiva
+    }
+}
+
+// Mantém a propriedade do Min Heap após a troca da raiz (espelho do Heapfy)
+void HeapfyMin (int heap[], int i, int n) {
+    int esq = filhoEsq(i);
+    int dir = filhoDir(i);
+    int menor = i;
+
+    // Filho esquerdo é menor que o pai
+    if (esq <= n && heap[esq] < heap[i]) {
+        menor = esq;
+    }
+
+    // Filho direito é menor que o pai ou o filho esquerdo
+    if (dir <= n && heap[dir] < heap[menor]) {
+        menor = dir;
+    }
+
+    if (menor != i) {
+        troca(&heap[menor], &heap[i]); // Desce o pai
+        HeapfyMin(heap, menor, n); // Chamada recursiva
+    }
+}
+
+// ##################################################### //
+// TOP-K DE VALORES
+
+// Inicializa o Top-K
+TopK *init_topK (int k) {
+    if (k < 0) {
+        printf("K inválido: %d.\n", k);
+        return NULL;
+    }
+
+    TopK *t = (TopK *)malloc(sizeof(TopK));
+
+    // Verifica a alocação de memória
+    if (t == NULL) {
+        printf("Não foi possível alocar memória para o Top-K.\n");
+        return NULL;
+    }
+
+    t->heap = (int *)malloc(sizeof(int) * (k + 1)); // +1 para o índice 0
+
+    // Verifica a alocação de memória
+    if (t->heap == NULL) {
+        printf("Não foi possível alocar memória para o heap do Top-K.\n");
+        free(t);
+        return NULL;
+    }
+
+    t->n = 0;
+    t->k = k;
+
+    return t;
+}
+
+// Oferece um valor ao Top-K
+void TopKInsere (TopK *t, int num) {
+    // Heap ainda não está cheio: inserção comum
+    if (t->n < t->k) {
+        t->n++;
+        t->heap[t->n] = num;
+        HeapSobeMin(t->heap, t->n);
+        return;
+    }
+
+    // K = 0: não guarda nenhum valor (o heap não tem a posição 1)
+    if (t->k == 0) {
+        return;
+    }
+
+    // Caminho rápido: não supera o menor dos K maiores
+    if (num <= t->heap[1]) {
+        return;
+    }
+
+    // Substitui a raiz e desce
+    t->heap[1] = num;
+    HeapfyMin(t->heap, 1, t->n);
+}
+
+// Oferece um lote de valores ao Top-K
+void TopKInsereLote (TopK *t, const int V[], int qtd) {
+    int i = 0;
+
+    // Completa o heap
+    while (i < qtd && t->n < t->k) {
+        TopKInsere(t, V[i]);
+        i++;
+    }
+
+    if (t->k == 0) {
+        return;
+    }
+
+    // Limiar guardado em variável local: o laço de rejeição não relê o heap
+    int limiar = t->heap[1];
+
+    for (; i < qtd; i++) {
+        // Caminho rápido: a maioria dos elementos para aqui
+        if (V[i] <= limiar) {
+            continue;
+        }
+
+        t->heap[1] = V[i];
+        HeapfyMin(t->heap, 1, t->n);
+        limiar = t->heap[1]; // O limiar só cresce
+    }
+}
+
+// Mescla o resultado parcial de origem (ex.: de outra thread) no destino
+void TopKMescla (TopK *destino, const TopK *origem) {
+    // Os elementos do heap de origem estão a partir do índice 1
+    TopKInsereLote(destino, origem->heap + 1, origem->n);
+}
+
+// Copia os K maiores valores para saida[0..n-1], em ordem decrescente. Retorna n
+int TopKResultado (const TopK *t, int saida[]) {
+    int n = t->n;
+
+    // Heap auxiliar (índice 0 desprezado)
+    int *aux = (int *)malloc(sizeof(int) * (n + 1));
+
+    // Verifica a alocação de memória
+    if (aux == NULL) {
+        printf("Não foi possível alocar memória para o resultado do Top-K.\n");
+        return 0;
+    }
+
+    for (int i = 1; i <= n; i++) {
+        aux[i] = t->heap[i];
+    }
+
+    // Remove sempre o menor e preenche a saída de trás para frente
+    for (int i = n; i >= 1; i--) {
+        saida[i - 1] = aux[1];
+        troca(&aux[1], &aux[i]);
+        HeapfyMin(aux, 1, i - 1);
+    }
+
+    free(aux);
+    return n;
+}
+
+// Libera a memória do Top-K
+void TopKLibera (TopK *t) {
+    free(t->heap);
+    free(t);
+}
+
+// ##################################################### //
+// HEAVY HITTERS (SPACE-SAVING)
+
+/*
+Obs.: o algoritmo Space-Saving monitora no máximo K chaves. Quando chega uma chave nova e todos os contadores estão ocupados, o contador de menor contagem (raiz do Min Heap) é reaproveitado: a nova chave herda a contagem antiga + 1 e o campo "erro" guarda quanto dessa contagem pode não ser dela. Toda chave com frequência real maior que N/K está garantidamente entre os contadores.
+*/
+
+// Mistura os bits da chave (Fibonacci) para indexar o mapa
+unsigned int hashChave (long int chave, unsigned int mascara) {
+    return (unsigned int)(((unsigned long int)chave * 11400714819323198485ul) >> 32) & mascara;
+}
+
+// Busca o índice do contador de uma chave no mapa (-1 se não monitorada)
+int mapaBusca (const HeavyHitters *h, long int chave) {
+    unsigned int i = hashChave(chave, h->mascara);
+
+    while (h->slots[i] != -1) {
+        if (h->chaves[i] == chave) {
+            return h->slots[i];
+        }
+        i = (i + 1) & h->mascara; // Probing linear
+    }
+
+    return -1;
+}
+
+// Associa uma chave a um contador no mapa
+void mapaInsere (HeavyHitters *h, long int chave, int slot) {
+    unsigned int i = hashChave(chave, h->mascara);
+
+    while (h->slots[i] != -1) {
+        i = (i + 1) & h->mascara;
+    }
+
+    h->chaves[i] = chave;
+    h->slots[i] = slot;
+}
+
+// Remove uma chave do mapa, deslocando para trás os elementos seguintes do agrupamento
+void mapaRemove (HeavyHitters *h, long int chave) {
+    unsigned int i = hashChave(chave, h->mascara);
+
+    while (h->slots[i] != -1 && h->chaves[i] != chave) {
+        i = (i + 1) & h->mascara;
+    }
+
+    if (h->slots[i] == -1) {
+        return; // Chave não está no mapa
+    }
+
+    // Backward-shift: puxa para o buraco os elementos que podem ocupá-lo
+    unsigned int j = i;
+    while (1) {
+        j = (j + 1) & h->mascara;
+
+        if (h->slots[j] == -1) {
+            break;
+        }
+
+        unsigned int ideal = hashChave(h->chaves[j], h->mascara);
+
+        // O elemento em j pode ir para o buraco i se o seu índice ideal não estiver em (i, j]
+        if (((j - ideal) & h->mascara) >= ((j - i) & h->mascara)) {
+            h->chaves[i] = h->chaves[j];
+            h->slots[i] = h->slots[j];
+            i = j;
+        }
+    }
+
+    h->slots[i] = -1;
+}
+
+// Troca duas posições do heap de contadores, atualizando as posições guardadas
+void trocaContador (HeavyHitters *h, int a, int b) {
+    troca(&h->heap[a], &h->heap[b]);
+    h->contadores[h->heap[a]].pos = a;
+    h->contadores[h->heap[b]].pos = b;
+}
+
+// HeapSobe pela contagem dos contadores
+void HeavySobe (HeavyHitters *h, int i) {
+    while (i > 1 && h->contadores[h->heap[pai(i)]].contagem > h->contadores[h->heap[i]].contagem) {
+        trocaContador(h, pai(i), i);
+        i = pai(i);
+    }
+}
+
+// Heapfy pela contagem dos contadores
+void HeavyDesce (HeavyHitters *h, int i) {
+    while (1) {
+        int esq = filhoEsq(i);
+        int dir = filhoDir(i);
+        int menor = i;
+
+        if (esq <= h->n && h->contadores[h->heap[esq]].contagem < h->contadores[h->heap[menor]].contagem) {
+            menor = esq;
+        }
+
+        if (dir <= h->n && h->contadores[h->heap[dir]].contagem < h->contadores[h->heap[menor]].contagem) {
+            menor = dir;
+        }
+
+        if (menor == i) {
+            break;
+        }
+
+        trocaContador(h, menor, i);
+        i = menor;
+    }
+}
+
+// Inicializa o rastreador de heavy hitters com K contadores
+HeavyHitters *init_heavy (int k) {
+    HeavyHitters *h = (HeavyHitters *)malloc(sizeof(HeavyHitters));
+
+    // Verifica a alocação de memória
+    if (h == NULL) {
+        printf("Não foi possível alocar memória para os heavy hitters.\n");
+        return NULL;
+    }
+
+    // Mapa com capacidade potência de 2 e ocupação máxima de 50%
+    unsigned int capacidade = 2;
+    while (capacidade < 2u * (unsigned int)k) {
+        capacidade *= 2;
+    }
+
+    h->contadores = (Contador *)malloc(sizeof(Contador) * k);
+    h->heap = (int *)malloc(sizeof(int) * (k + 1));
+    h->chaves = (long int *)malloc(sizeof(long int) * capacidade);
+    h->slots = (int *)malloc(sizeof(int) * capacidade);
+
+    // Verifica a alocação de memória
+    if (h->contadores == NULL || h->heap == NULL || h->chaves == NULL || h->slots == NULL) {
+        printf("Não foi possível alocar memória para os contadores.\n");
+        HeavyLibera(h);
+        return NULL;
+    }
+
+    for (unsigned int i = 0; i < capacidade; i++) {
+        h->slots[i] = -1;
+    }
+
+    h->mascara = capacidade - 1;
+    h->n = 0;
+    h->k = k;
+
+    return h;
+}
+
+// Contabiliza "peso" ocorrências de uma chave
+void HeavyInsere (HeavyHitters *h, long int chave, long int peso) {
+    int c = mapaBusca(h, chave);
+
+    // Chave já monitorada: incrementa e desce no heap
+    if (c != -1) {
+        h->contadores[c].contagem += peso;
+        HeavyDesce(h, h->contadores[c].pos);
+        return;
+    }
+
+    // Ainda há contadores livres
+    if (h->n < h->k) {
+        c = h->n;
+        h->n++;
+        h->contadores[c].chave = chave;
+        h->contadores[c].contagem = peso;
+        h->contadores[c].erro = 0;
+        h->contadores[c].pos = h->n;
+        h->heap[h->n] = c;
+        mapaInsere(h, chave, c);
+        HeavySobe(h, h->n);
+        return;
+    }
+
+    if (h->k == 0) {
+        return;
+    }
+
+    // Reaproveita o contador de menor contagem
+    c = h->heap[1];
+    mapaRemove(h, h->contadores[c].chave);
+    h->contadores[c].erro = h->contadores[c].contagem;
+    h->contadores[c].contagem += peso;
+    h->contadores[c].chave = chave;
+    mapaInsere(h, chave, c);
+    HeavyDesce(h, 1);
+}
+
+// Contabiliza um lote de chaves
+void HeavyInsereLote (HeavyHitters *h, const long int V[], int qtd) {
+    for (int i = 0; i < qtd; i++) {
+        HeavyInsere(h, V[i], 1);
+    }
+}
+
+// Mescla o resumo de origem (ex.: de outra thread) no destino
+void HeavyMescla (HeavyHitters *destino, const HeavyHitters *origem) {
+    for (int i = 0; i < origem->n; i++) {
+        const Contador *c = &origem->contadores[i];
+        HeavyInsere(destino, c->chave, c->contagem);
+
+        // O erro da origem se acumula no contador da chave no destino
+        int d = mapaBusca(destino, c->chave);
+        if (d != -1) {
+            destino->contadores[d].erro += c->erro;
+        }
+    }
+}
+
+// Exibe os contadores em ordem decrescente de contagem
+void HeavyImprime (const HeavyHitters *h) {
+    int *ordem = (int *)malloc(sizeof(int) * h->n);
+
+    // Verifica a alocação de memória
+    if (ordem == NULL) {
+        printf("Não foi possível alocar memória para a impressão.\n");
+        return;
+    }
+
+    // Insertion sort dos índices pela contagem (K é pequeno)
+    for (int i = 0; i < h->n; i++) {
+        int j = i - 1;
+        while (j >= 0 && h->contadores[ordem[j]].contagem < h->contadores[i].contagem) {
+            ordem[j + 1] = ordem[j];
+            j--;
+        }
+        ordem[j + 1] = i;
+    }
+
+    for (int i = 0; i < h->n; i++) {
+        const Contador *c = &h->contadores[ordem[i]];
+        printf("Chave %ld: contagem <= %ld (erro <= %ld)\n", c->chave, c->contagem, c->erro);
+    }
+
+    free(ordem);
+}
+
+// Libera a memória do rastreador
+void HeavyLibera (HeavyHitters *h) {
+    free(h->contadores);
+    free(h->heap);
+    free(h->chaves);
+    free(h->slots);
+    free(h);
+}
+
+// ##################################################### //
+// DEMONSTRAÇÃO COM THREADS
+
+// Parâmetros de cada thread: uma fatia do fluxo e os resultados parciais
+typedef struct Fatia {
+    const int *valores;
+    const long int *chaves;
+    int qtd;
+    TopK *topK;
+    HeavyHitters *heavy;
+} Fatia;
+
+// Cada thread processa sua fatia sem sincronização
+void *processaFatia (void *arg) {
+    Fatia *f = (Fatia *)arg;
+    TopKInsereLote(f->topK, f->valores, f->qtd);
+    HeavyInsereLote(f->heavy, f->chaves, f->qtd);
+    return NULL;
+}
+
+int main () {
+    int k = 5;
+    int qtd = 1000000;
+
+    int *valores = (int *)malloc(sizeof(int) * qtd);
+    long int *chaves = (long int *)malloc(sizeof(long int) * qtd);
+
+    // Verifica a alocação de memória
+    if (valores == NULL || chaves == NULL) {
+        printf("Não foi possível alocar memória para o fluxo.\n");
+        return 1;
+    }
+
+    // Gera o fluxo: valores aleatórios e chaves com algumas matrículas muito frequentes
+    srand(42);
+    for (int i = 0; i < qtd; i++) {
+        valores[i] = rand();
+
+        if (i % 10 < 4) {
+            chaves[i] = 20230000000 + (i % 3); // 40% do fluxo em 3 matrículas
+        }
+        else {
+            chaves[i] = 20230000000 + rand() % 100000;
+        }
+    }
+
+    // Cada thread acumula um resultado parcial
+    pthread_t threads[qtdThreads];
+    Fatia fatias[qtdThreads];
+    int tamFatia = qtd / qtdThreads;
+
+    for (int t = 0; t < qtdThreads; t++) {
+        fatias[t].valores = valores + t * tamFatia;
+        fatias[t].chaves = chaves + t * tamFatia;
+        fatias[t].qtd = (t == qtdThreads - 1) ? qtd - t * tamFatia : tamFatia;
+        fatias[t].topK = init_topK(k);
+        fatias[t].heavy = init_heavy(4 * k);
+        pthread_create(&threads[t], NULL, processaFatia, &fatias[t]);
+    }
+
+    // Mescla os resultados parciais
+    TopK *topK = init_topK(k);
+    HeavyHitters *heavy = init_heavy(4 * k);
+
+    for (int t = 0; t < qtdThreads; t++) {
+        pthread_join(threads[t], NULL);
+        TopKMescla(topK, fatias[t].topK);
+        HeavyMescla(heavy, fatias[t].heavy);
+        TopKLibera(fatias[t].topK);
+        HeavyLibera(fatias[t].heavy);
+    }
+
+    // Exibe os K maiores valores
+    int *saida = (int *)malloc(sizeof(int) * k);
+    int n = TopKResultado(topK, saida);
+    printf("Top-%d valores: ", k);
+    for (int i = 0; i < n; i++) {
+        printf("%d ", saida[i]);
+    }
+    printf("\n\n");
+
+    // Confere com uma varredura completa
+    TopK *conferencia = init_topK(k);
+    for (int i = 0; i < qtd; i++) {
+        TopKInsere(conferencia, valores[i]);
+    }
+    int *esperado = (int *)malloc(sizeof(int) * k);
+    TopKResultado(conferencia, esperado);
+    int iguais = 1;
+    for (int i = 0; i < n; i++) {
+        if (saida[i] != esperado[i]) {
+            iguais = 0;
+        }
+    }
+    printf("Resultado mesclado %s a varredura sequencial.\n\n", iguais ? "confere com" : "DIVERGE de");
+
+    // Exibe as matrículas mais frequentes
+    printf("Matrículas mais frequentes:\n");
+    HeavyImprime(heavy);
+
+    // Libera a memória
+    free(saida);
+    free(esperado);
+    free(valores);
+    free(chaves);
+    TopKLibera(topK);
+    TopKLibera(conferencia);
+    HeavyLibera(heavy);
+
+    return 0;
+}
@@ -0,0 +1,670 @@
+// ## Índice Ordenado Log-Structured Merge (LSM) ##
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define tamMemtable 4096 // Capacidade do buffer de escrita em memória
+#define maxRuns 64 // Máximo de runs imutáveis antes de a escrita esperar a compactação
+#define bitsPorChave 10 // Filtro de Bloom: ~1% de falsos positivos com 7 funções
+#define qtdHashes 7
+
+/*
+Obs.: inserir em um vetor ordenado custa O(n) por causa do deslocamento. A árvore LSM evita isso:
+
+1) As escritas vão para um vetor ordenado pequeno em memória (memtable), onde o deslocamento é barato.
+2) Quando a memtable enche, ela vira um "run": um vetor ordenado imutável, inserido no início da lista de runs (do mais novo para o mais antigo).
+3) Uma thread de compactação intercala runs vizinhos de tamanhos parecidos com o merge do MergeSort.c, e o número de runs fica em O(log n). Runs imutáveis podem ser lidos enquanto o novo run é construído; só a troca na lista precisa de trava exclusiva.
+4) Uma busca consulta a memtable e depois os runs do mais novo para o mais antigo; a primeira ocorrência encontrada vale. Cada run guarda o menor e o maior elemento e um filtro de Bloom, que descartam a maioria dos runs sem nenhuma busca binária.
+
+Remoções são escritas como lápides (entradas marcadas como removidas), que escondem as versões mais antigas e só são descartadas quando chegam ao run mais antigo.
+*/
+
+// Entrada de um run ou da memtable
+typedef struct Entrada {
+    int chave;
+    int removida; // 1 = lápide
+} Entrada;
+
+// Run imutável
+typedef struct Run {
+    Entrada *e;
+    int n;
+    int min; // Menor chave do run
+    int max; // Maior chave do run
+    unsigned long int *filtro; // Filtro de Bloom
+    unsigned int bitsFiltro;
+} Run;
+
+// Estrutura do índice
+typedef struct LSM {
+    Entrada *mem; // Memtable ordenada
+    int qtdMem;
+    Run *runs[maxRuns]; // runs[0] é o mais novo
+    int qtdRuns;
+    pthread_rwlock_t trava; // Protege a memtable e a lista de runs
+    pthread_mutex_t travaCompactacao; // Uma compactação por vez
+    pthread_mutex_t travaSinal;
+    pthread_cond_t sinal; // Acorda a thread de compactação
+    int pendente; // Há runs novos a compactar
+    int encerrar;
+    pthread_t compactador;
+    long int runsDescartados; // Runs pulados por min/max ou filtro (estatística)
+} LSM;
+
+// Cabeçalho
+LSM *init_lsm ();
+int LSMInsere (LSM *t, int chave);
+int LSMRemove (LSM *t, int chave);
+int LSMBusca (LSM *t, int chave);
+int LSMIntervalo (LSM *t, int a, int b, int saida[], int max);
+void LSMAguardaCompactacao (LSM *t);
+void LSMLibera (LSM *t);
+
+// ##################################################### //
+// FILTRO DE BLOOM
+
+// Mistura os bits da chave
+unsigned long int misturaChave (int chave) {
+    unsigned long int x = (unsigned int)chave;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdul;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ul;
+    x ^= x >> 33;
+    return x;
+}
+
+// Marca a chave no filtro (hashing duplo: h1 + i * h2)
+void filtroInsere (Run *r, int chave) {
+    unsigned long int h = misturaChave(chave);
+    unsigned int h1 = (unsigned int)h;
+    unsigned int h2 = (unsigned int)(h >> 32) | 1;
+
+    for (int i = 0; i < qtdHashes; i++) {
+        unsigned int bit = (h1 + i * h2) % r->bitsFiltro;
+        r->filtro[bit / 64] |= 1ul << (bit % 64);
+    }
+}
+
+// Retorna 0 se a chave certamente não está no run
+int filtroTalvez (const Run *r, int chave) {
+    unsigned long int h = misturaChave(chave);
+    unsigned int h1 = (unsigned int)h;
+    unsigned int h2 = (unsigned int)(h >> 32) | 1;
+
+    for (int i = 0; i < qtdHashes; i++) {
+        unsigned int bit = (h1 + i * h2) % r->bitsFiltro;
+        if (!(r->filtro[bit / 64] & (1ul << (bit % 64)))) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// ##################################################### //
+// RUNS
+
+// Cria um run a partir de entradas ordenadas (o vetor passa a pertencer ao run)
+Run *init_run (Entrada *e, int n) {
+    Run *r = (Run *)malloc(sizeof(Run));
+
+    // Verifica a alocação de memória
+    if (r == NULL) {
+        printf("Não foi possível alocar memória para o run.\n");
+        return NULL;
+    }
+
+    r->e = e;
+    r->n = n;
+    r->min = (n > 0) ? e[0].chave : 0;
+    r->max = (n > 0) ? e[n - 1].chave : -1;
+    r->bitsFiltro = (unsigned int)(n * bitsPorChave / 64 + 1) * 64;
+    r->filtro = (unsigned long int *)calloc(r->bitsFiltro / 64, sizeof(unsigned long int));
+
+    // Verifica a alocação de memória
+    if (r->filtro == NULL) {
+        printf("Não foi possível alocar memória para o filtro do run.\n");
+        free(r);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; i++) {
+        filtroInsere(r, e[i].chave);
+    }
+
+    return r;
+}
+
+// Libera a memória do run
+void liberaRun (Run *r) {
+    free(r->e);
+    free(r->filtro);
+    free(r);
+}
+
+// Busca binária (BuscaBinaria.c) nas entradas. Retorna o índice ou -1
+int buscaBinaria (const Entrada A[], int n, int k) {
+    int ini = 0;
+    int fim = n - 1;
+
+    while (ini <= fim) {
+        int meio = ini + (fim - ini) / 2;
+        if (k < A[meio].chave) {
+            fim = meio - 1;
+        }
+        else if (k > A[meio].chave) {
+            ini = meio + 1;
+        }
+        else {
+            return meio;
+        }
+    }
+
+    return -1;
+}
+
+// Primeiro índice com A[i].chave >= k
+int lowerBound (const Entrada A[], int n, int k) {
+    int ini = 0;
+    int fim = n;
+
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        if (A[meio].chave < k) {
+            ini = meio + 1;
+        }
+        else {
+            fim = meio;
+        }
+    }
+
+    return ini;
+}
+
+// Intercala dois runs ordenados (merge do MergeSort.c). Em chaves repetidas vale a entrada do run mais novo.
+// Sem sentinelas INT_MAX, para que a própria chave INT_MAX seja válida. Retorna o tamanho de V
+int merge (Entrada *V, const Entrada *novo, int tamNovo, const Entrada *velho, int tamVelho, int descartaLapides) {
+    int i = 0, j = 0, k = 0;
+
+    while (i < tamNovo || j < tamVelho) {
+        Entrada escolhida;
+
+        if (j >= tamVelho || (i < tamNovo && novo[i].chave < velho[j].chave)) {
+            escolhida = novo[i++];
+        }
+        else if (i >= tamNovo || velho[j].chave < novo[i].chave) {
+            escolhida = velho[j++];
+        }
+        else {
+            escolhida = novo[i++]; // Mesma chave: a versão nova esconde a antiga
+            j++;
+        }
+
+        // No run mais antigo, lápides não escondem mais nada
+        if (!(descartaLapides && escolhida.removida)) {
+            V[k++] = escolhida;
+        }
+    }
+
+    return k;
+}
+
+// ##################################################### //
+// COMPACTAÇÃO
+
+// Escolhe e intercala um par de runs vizinhos. forca = 1 aceita qualquer par. Retorna 1 se compactou
+int compactaUmaVez (LSM *t, int forca) {
+    pthread_mutex_lock(&t->travaCompactacao);
+
+    // Escolhe o par: run novo com pelo menos metade do tamanho do vizinho mais antigo
+    pthread_rwlock_rdlock(&t->trava);
+    int escolhido = -1;
+    for (int i = 0; i + 1 < t->qtdRuns; i++) {
+        if (2 * t->runs[i]->n >= t->runs[i + 1]->n) {
+            escolhido = i;
+            break;
+        }
+    }
+
+    // Sem par pela regra: com força, o par de menor tamanho somado
+    if (escolhido == -1 && forca) {
+        for (int i = 0; i + 1 < t->qtdRuns; i++) {
+            if (escolhido == -1 || t->runs[i]->n + t->runs[i + 1]->n < t->runs[escolhido]->n + t->runs[escolhido + 1]->n) {
+                escolhido = i;
+            }
+        }
+    }
+
+    if (escolhido == -1) {
+        pthread_rwlock_unlock(&t->trava);
+        pthread_mutex_unlock(&t->travaCompactacao);
+        return 0;
+    }
+
+    Run *a = t->runs[escolhido]; // Mais novo
+    Run *b = t->runs[escolhido + 1]; // Mais antigo
+    int ultimo = (escolhido + 1 == t->qtdRuns - 1); // Só a compactação remove runs: b continua o último
+    pthread_rwlock_unlock(&t->trava);
+
+    // Intercala fora da trava: a e b são imutáveis
+    Entrada *e = (Entrada *)malloc(sizeof(Entrada) * (a->n + b->n + 1));
+    Run *novo = NULL;
+
+    if (e != NULL) {
+        int n = merge(e, a->e, a->n, b->e, b->n, ultimo);
+        novo = init_run(e, n);
+    }
+
+    if (novo == NULL) {
+        printf("Não foi possível compactar os runs.\n");
+        free(e);
+        pthread_mutex_unlock(&t->travaCompactacao);
+        return 0;
+    }
+
+    // Troca a e b pelo novo run. Runs novos só entram no início, então a e b continuam vizinhos
+    pthread_rwlock_wrlock(&t->trava);
+    int pos = 0;
+    while (t->runs[pos] != a) {
+        pos++;
+    }
+
+    t->runs[pos] = novo;
+    for (int i = pos + 1; i + 1 < t->qtdRuns; i++) {
+        t->runs[i] = t->runs[i + 1];
+    }
+    t->qtdRuns--;
+    pthread_rwlock_unlock(&t->trava);
+
+    // Nenhum leitor enxerga mais a e b
+    liberaRun(a);
+    liberaRun(b);
+
+    pthread_mutex_unlock(&t->travaCompactacao);
+    return 1;
+}
+
+// Thread de compactação em segundo plano
+void *compactador (void *arg) {
+    LSM *t = (LSM *)arg;
+
+    while (1) {
+        pthread_mutex_lock(&t->travaSinal);
+        while (!t->pendente && !t->encerrar) {
+            pthread_cond_wait(&t->sinal, &t->travaSinal);
+        }
+        int encerrar = t->encerrar;
+        t->pendente = 0;
+        pthread_mutex_unlock(&t->travaSinal);
+
+        if (encerrar) {
+            break;
+        }
+
+        while (compactaUmaVez(t, 0)) {
+            // Compacta enquanto houver pares pela regra
+        }
+    }
+
+    return NULL;
+}
+
+// Compacta de forma síncrona até não haver mais pares pela regra
+void LSMAguardaCompactacao (LSM *t) {
+    while (compactaUmaVez(t, 0)) {
+        // Compacta enquanto houver pares pela regra
+    }
+}
+
+// ##################################################### //
+// ÍNDICE
+
+// Inicializa o índice e a thread de compactação
+LSM *init_lsm () {
+    LSM *t = (LSM *)calloc(1, sizeof(LSM));
+
+    // Verifica a alocação de memória
+    if (t == NULL) {
+        printf("Não foi possível alocar memória para o índice.\n");
+        return NULL;
+    }
+
+    t->mem = (Entrada *)malloc(sizeof(Entrada) * tamMemtable);
+
+    // Verifica a alocação de memória
+    if (t->mem == NULL) {
+        printf("Não foi possível alocar memória para a memtable.\n");
+        free(t);
+        return NULL;
+    }
+
+    pthread_rwlock_init(&t->trava, NULL);
+    pthread_mutex_init(&t->travaCompactacao, NULL);
+    pthread_mutex_init(&t->travaSinal, NULL);
+    pthread_cond_init(&t->sinal, NULL);
+
+    if (pthread_create(&t->compactador, NULL, compactador, t) != 0) {
+        printf("Não foi possível criar a thread de compactação.\n");
+        pthread_rwlock_destroy(&t->trava);
+        pthread_mutex_destroy(&t->travaCompactacao);
+        pthread_mutex_destroy(&t->travaSinal);
+        pthread_cond_destroy(&t->sinal);
+        free(t->mem);
+        free(t);
+        return NULL;
+    }
+
+    return t;
+}
+
+// Transforma a memtable em um run (com a trava exclusiva). Retorna 0 em caso de falha
+int descarregaMemtable (LSM *t) {
+    Entrada *e = (Entrada *)malloc(sizeof(Entrada) * (t->qtdMem + 1));
+
+    // Verifica a alocação de memória
+    if (e == NULL) {
+        printf("Não foi possível alocar memória para o run.\n");
+        return 0;
+    }
+
+    memcpy(e, t->mem, sizeof(Entrada) * t->qtdMem);
+    Run *r = init_run(e, t->qtdMem);
+
+    if (r == NULL) {
+        free(e);
+        return 0;
+    }
+
+    // O run novo entra no início da lista
+    for (int i = t->qtdRuns; i > 0; i--) {
+        t->runs[i] = t->runs[i - 1];
+    }
+    t->runs[0] = r;
+    t->qtdRuns++;
+    t->qtdMem = 0;
+
+    return 1;
+}
+
+// Descarrega a memtable se estiver cheia (com a trava exclusiva, que pode ser liberada temporariamente).
+// Retorna 0 em caso de falha
+int garanteEspaco (LSM *t, int *descarregou) {
+    while (t->qtdMem == tamMemtable) {
+        // Lista de runs cheia: a escrita ajuda a compactar antes de descarregar
+        if (t->qtdRuns == maxRuns) {
+            pthread_rwlock_unlock(&t->trava);
+            int compactou = compactaUmaVez(t, 1);
+            pthread_rwlock_wrlock(&t->trava);
+
+            // Compactação falhou (sem memória) e a lista continua cheia: não tenta de novo para sempre
+            if (!compactou && t->qtdRuns == maxRuns) {
+                return 0;
+            }
+            continue; // Outra escrita pode ter descarregado enquanto a trava estava livre
+        }
+
+        if (!descarregaMemtable(t)) {
+            return 0;
+        }
+        *descarregou = 1;
+    }
+
+    return 1;
+}
+
+// Escreve uma entrada na memtable, descarregando-a quando enche. Retorna 0 em caso de falha
+int escreve (LSM *t, int chave, int removida) {
+    int descarregou = 0;
+    int ok = 1;
+
+    pthread_rwlock_wrlock(&t->trava);
+
+    int i = lowerBound(t->mem, t->qtdMem, chave);
+
+    if (i < t->qtdMem && t->mem[i].chave == chave) {
+        // Chave já está na memtable: só atualiza
+        t->mem[i].removida = removida;
+    }
+    else if (garanteEspaco(t, &descarregou)) {
+        i = lowerBound(t->mem, t->qtdMem, chave);
+
+        if (i < t->qtdMem && t->mem[i].chave == chave) {
+            // Outra escrita inseriu a chave enquanto a trava estava livre: só atualiza
+            t->mem[i].removida = removida;
+        }
+        else {
+            // Desloca para abrir espaço (barato: a memtable é pequena)
+            memmove(&t->mem[i + 1], &t->mem[i], sizeof(Entrada) * (t->qtdMem - i));
+            t->mem[i].chave = chave;
+            t->mem[i].removida = removida;
+            t->qtdMem++;
+
+            ok = garanteEspaco(t, &descarregou);
+        }
+    }
+    else {
+        ok = 0;
+    }
+
+    pthread_rwlock_unlock(&t->trava);
+
+    // Acorda a compactação
+    if (descarregou) {
+        pthread_mutex_lock(&t->travaSinal);
+        t->pendente = 1;
+        pthread_cond_signal(&t->sinal);
+        pthread_mutex_unlock(&t->travaSinal);
+    }
+
+    return ok;
+}
+
+// Insere uma chave. Retorna 0 em caso de falha
+int LSMInsere (LSM *t, int chave) {
+    return escreve(t, chave, 0);
+}
+
+// Remove uma chave (escreve uma lápide). Retorna 0 em caso de falha
+int LSMRemove (LSM *t, int chave) {
+    return escreve(t, chave, 1);
+}
+
+// Retorna 1 se a chave está no índice
+int LSMBusca (LSM *t, int chave) {
+    pthread_rwlock_rdlock(&t->trava);
+
+    int i = buscaBinaria(t->mem, t->qtdMem, chave);
+    if (i != -1) {
+        int presente = !t->mem[i].removida;
+        pthread_rwlock_unlock(&t->trava);
+        return presente;
+    }
+
+    long int descartados = 0;
+    int presente = 0;
+
+    // Do run mais novo para o mais antigo
+    for (int r = 0; r < t->qtdRuns; r++) {
+        const Run *run = t->runs[r];
+
+        if (chave < run->min || chave > run->max || !filtroTalvez(run, chave)) {
+            descartados++;
+            continue;
+        }
+
+        i = buscaBinaria(run->e, run->n, chave);
+        if (i != -1) {
+            presente = !run->e[i].removida;
+            break;
+        }
+    }
+
+    pthread_rwlock_unlock(&t->trava);
+    __atomic_fetch_add(&t->runsDescartados, descartados, __ATOMIC_RELAXED);
+
+    return presente;
+}
+
+// Copia para saida (até max) as chaves em [a, b), em ordem. Retorna a quantidade total de chaves no intervalo
+int LSMIntervalo (LSM *t, int a, int b, int saida[], int max) {
+    pthread_rwlock_rdlock(&t->trava);
+
+    // Fontes: memtable (a mais nova) e runs, cada uma com um cursor no lower bound de a
+    int qtdFontes = t->qtdRuns + 1;
+    const Entrada *fonte[maxRuns + 1];
+    int tam[maxRuns + 1];
+    int cursor[maxRuns + 1];
+
+    fonte[0] = t->mem;
+    tam[0] = t->qtdMem;
+    for (int r = 0; r < t->qtdRuns; r++) {
+        fonte[r + 1] = t->runs[r]->e;
+        tam[r + 1] = t->runs[r]->n;
+    }
+    for (int f = 0; f < qtdFontes; f++) {
+        cursor[f] = lowerBound(fonte[f], tam[f], a);
+    }
+
+    int total = 0;
+
+    while (1) {
+        // Menor chave entre os cursores; em empate, a fonte mais nova (menor f)
+        int melhor = -1;
+        for (int f = 0; f < qtdFontes; f++) {
+            if (cursor[f] < tam[f] && fonte[f][cursor[f]].chave < b &&
+                (melhor == -1 || fonte[f][cursor[f]].chave < fonte[melhor][cursor[melhor]].chave)) {
+                melhor = f;
+            }
+        }
+
+        if (melhor == -1) {
+            break;
+        }
+
+        Entrada e = fonte[melhor][cursor[melhor]];
+
+        // Avança todos os cursores parados nessa chave (versões antigas)
+        for (int f = 0; f < qtdFontes; f++) {
+            if (cursor[f] < tam[f] && fonte[f][cursor[f]].chave == e.chave) {
+                cursor[f]++;
+            }
+        }
+
+        if (!e.removida) {
+            if (total < max) {
+                saida[total] = e.chave;
+            }
+            total++;
+        }
+    }
+
+    pthread_rwlock_unlock(&t->trava);
+    return total;
+}
+
+// Encerra a compactação e libera a memória
+void LSMLibera (LSM *t) {
+    pthread_mutex_lock(&t->travaSinal);
+    t->encerrar = 1;
+    pthread_cond_signal(&t->sinal);
+    pthread_mutex_unlock(&t->travaSinal);
+    pthread_join(t->compactador, NULL);
+
+    for (int r = 0; r < t->qtdRuns; r++) {
+        liberaRun(t->runs[r]);
+    }
+
+    pthread_rwlock_destroy(&t->trava);
+    pthread_mutex_destroy(&t->travaCompactacao);
+    pthread_mutex_destroy(&t->travaSinal);
+    pthread_cond_destroy(&t->sinal);
+    free(t->mem);
+    free(t);
+}
+
+// Exibe os tamanhos dos runs
+void LSMImprime (LSM *t) {
+    pthread_rwlock_rdlock(&t->trava);
+    printf("memtable = %d | runs (%d):", t->qtdMem, t->qtdRuns);
+    for (int r = 0; r < t->qtdRuns; r++) {
+        printf(" %d", t->runs[r]->n);
+    }
+    printf("\n");
+    pthread_rwlock_unlock(&t->trava);
+}
+
+int main () {
+    int universo = 2000000;
+    int qtdOperacoes = 1000000;
+
+    LSM *t = init_lsm();
+    char *referencia = (char *)calloc(universo, sizeof(char)); // Presença de cada chave
+
+    // Verifica a alocação de memória
+    if (t == NULL || referencia == NULL) {
+        printf("Não foi possível alocar memória.\n");
+        return 1;
+    }
+
+    // Inserções e remoções aleatórias (20% de remoções)
+    srand(23);
+    for (int i = 0; i < qtdOperacoes; i++) {
+        int chave = (int)((((long int)rand() << 16) ^ rand()) % universo);
+
+        if (rand() % 5 == 0) {
+            LSMRemove(t, chave);
+            referencia[chave] = 0;
+        }
+        else {
+            LSMInsere(t, chave);
+            referencia[chave] = 1;
+        }
+    }
+
+    printf("Após %d operações:\n", qtdOperacoes);
+    LSMImprime(t);
+    LSMAguardaCompactacao(t);
+    printf("Após a compactação:\n");
+    LSMImprime(t);
+    printf("\n");
+
+    // Busca pontual conferida com a referência
+    int erros = 0;
+    for (int chave = 0; chave < universo; chave++) {
+        if (LSMBusca(t, chave) != referencia[chave]) {
+            erros++;
+        }
+    }
+    printf("Busca pontual em %d chaves: %d divergências (%ld runs descartados por min/max ou filtro).\n", universo, erros, t->runsDescartados);
+
+    // Consultas por intervalo conferidas com a referência
+    int saida[100];
+    erros = 0;
+    for (int q = 0; q < 2000; q++) {
+        int a = rand() % universo;
+        int b = a + rand() % 5000;
+        int esperado = 0;
+        for (int k = a; k < b && k < universo; k++) {
+            esperado += referencia[k];
+        }
+        if (LSMIntervalo(t, a, b, saida, 100) != esperado) {
+            erros++;
+        }
+    }
+    printf("Consultas por intervalo: %d divergências.\n", erros);
+
+    int n = LSMIntervalo(t, 1000, 1100, saida, 100);
+    printf("Chaves em [1000, 1100) (%d):", n);
+    for (int i = 0; i < n && i < 100; i++) {
+        printf(" %d", saida[i]);
+    }
+    printf("\n");
+
+    LSMLibera(t);
+    free(referencia);
+
+    return 0;
+}